@@ -0,0 +1,222 @@
+/**
+ * @file Arduino.cpp
+ * @brief Pins and attached interrupts of the stand-in kept in RAM, time read from NativeClock, and
+ *        the host side functions arduinoNative_xxx() that drive the pins.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - pins, interrupts and time of the stand-in
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stdio.h>
+#include "Arduino.h"
+#include "NativeClock.h"
+#include "NativeBoard.h"
+#include "NativeSession.h"
+
+// State of a pin
+typedef struct t_nativePin{
+    uint8_t mode;
+    uint8_t level;                  // level read, written by the firmware on an output
+    bool driven;                    // level applied by the host on an input
+    int analog;                     // analog value, ARDUINO_NATIVE_ANALOG_BITS
+    NativeAnalogSource source;      // analog value computed at each conversion
+    void *sourceContext;
+    voidFuncPtr callback;           // attached interrupt
+    int interruptMode;
+} NATIVE_PIN;
+
+static NATIVE_PIN pins[NUM_DIGITAL_PINS];
+static bool interruptsEnabled = true;
+
+NativeSerial Serial;
+
+unsigned long millis(void){
+  nativeClock_poll();
+  return nativeClock_us() / 1000;
+}
+
+unsigned long micros(void){
+  nativeClock_poll();
+  return nativeClock_us();
+}
+
+void delay(unsigned long ms){
+  nativeClock_sleep_us(ms * 1000ULL);
+}
+
+void delayMicroseconds(unsigned int us){
+  nativeClock_sleep_us(us);
+}
+
+void pinMode(uint8_t pin, uint8_t mode){
+  if(pin >= NUM_DIGITAL_PINS)
+    return;
+  pins[pin].mode = mode;
+  // an input not driven by the host follows its pull resistor
+  if(mode != OUTPUT && !pins[pin].driven)
+    pins[pin].level = mode == INPUT_PULLUP ? HIGH : LOW;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value){
+  if(pin >= NUM_DIGITAL_PINS || pins[pin].mode != OUTPUT)
+    return;
+  pins[pin].level = value ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin){
+  if(pin >= NUM_DIGITAL_PINS)
+    return LOW;
+  nativeClock_poll();
+  return pins[pin].level;
+}
+
+int analogRead(uint8_t pin){
+  if(pin >= NUM_DIGITAL_PINS)
+    return 0;
+  nativeClock_poll();
+  nativeClock_spend_us(ARDUINO_NATIVE_ANALOG_TIME_US);
+  if(pins[pin].source)
+    return pins[pin].source(pins[pin].sourceContext);
+  return pins[pin].analog;
+}
+
+void analogWrite(uint8_t pin, int value){
+  digitalWrite(pin, value ? HIGH : LOW);
+}
+
+void attachInterrupt(uint8_t interrupt, voidFuncPtr callback, int mode){
+  if(interrupt >= NUM_DIGITAL_PINS)
+    return;
+  pins[interrupt].callback = callback;
+  pins[interrupt].interruptMode = mode;
+}
+
+void detachInterrupt(uint8_t interrupt){
+  if(interrupt >= NUM_DIGITAL_PINS)
+    return;
+  pins[interrupt].callback = NULL;
+}
+
+void noInterrupts(void){
+  interruptsEnabled = false;
+}
+
+void interrupts(void){
+  interruptsEnabled = true;
+}
+
+long map(long value, long fromLow, long fromHigh, long toLow, long toHigh){
+  return (value - fromLow) * (toHigh - toLow) / (fromHigh - fromLow) + toLow;
+}
+
+/**
+ * @brief Apply a level to an input, the attached interrupt is called on the matching edge
+ *
+ * @param pin input
+ * @param value HIGH or LOW
+ */
+void arduinoNative_setPin(uint8_t pin, int value){
+  NATIVE_PIN *nativePin;
+  uint8_t previous;
+
+  if(pin >= NUM_DIGITAL_PINS)
+    return;
+  nativePin = &pins[pin];
+  previous = nativePin->level;
+  nativePin->driven = true;
+  nativePin->level = value ? HIGH : LOW;
+  if(!nativePin->callback || !interruptsEnabled)
+    return;
+  if((nativePin->interruptMode == CHANGE && previous != nativePin->level) ||
+     (nativePin->interruptMode == RISING && !previous && nativePin->level) ||
+     (nativePin->interruptMode == FALLING && previous && !nativePin->level) ||
+     (nativePin->interruptMode == HIGH && nativePin->level) ||
+     (nativePin->interruptMode == LOW && !nativePin->level))
+    nativePin->callback();
+}
+
+/**
+ * @brief Apply an analog value to an input
+ *
+ * @param pin analog input
+ * @param value ADC value, ARDUINO_NATIVE_ANALOG_BITS
+ */
+void arduinoNative_setAnalog(uint8_t pin, int value){
+  if(pin >= NUM_DIGITAL_PINS)
+    return;
+  pins[pin].analog = value;
+  pins[pin].source = NULL;
+}
+
+/**
+ * @brief Compute the analog value of an input at each conversion (signal of a host model)
+ *
+ * @param pin analog input
+ * @param source function giving the ADC value at the current time, NULL to keep the last value
+ * @param context given to the function
+ */
+void arduinoNative_setAnalogSource(uint8_t pin, NativeAnalogSource source, void *context){
+  if(pin >= NUM_DIGITAL_PINS)
+    return;
+  pins[pin].source = source;
+  pins[pin].sourceContext = context;
+}
+
+/**
+ * @brief Level of a pin written by the firmware
+ *
+ * @param pin output
+ * @return int HIGH or LOW
+ */
+int arduinoNative_getPin(uint8_t pin){
+  return digitalRead(pin);
+}
+
+/**
+ * @brief Time of a measurement, not a poll: the virtual clock is not moved by the reads of
+ *        a profiler as SysTick is not on the target
+ *
+ * @return unsigned long time [us]
+ */
+unsigned long arduinoNative_micros(void){
+  return nativeClock_us();
+}
+
+void NativeSerial::begin(unsigned long baudrate){
+  (void)baudrate;
+}
+
+void NativeSerial::end(void){
+}
+
+int NativeSerial::available(void){
+  return 0;
+}
+
+int NativeSerial::read(void){
+  return -1;
+}
+
+void NativeSerial::flush(void){
+  fflush(stdout);
+}
+
+size_t NativeSerial::write(uint8_t c){
+  return putchar(c) == EOF ? 0 : 1;
+}
+
+#ifndef PIO_UNIT_TESTING
+// The unit tests have their own entry point
+int main(void){
+  nativeBoard_attach();
+  // a simulated session (ARDUINO_NATIVE_SESSION) ends the loop after its duration
+  nativeSession_begin();
+  setup();
+  while(!nativeSession_finished())
+    loop();
+  return nativeSession_report();
+}
+#endif
@@ -0,0 +1,126 @@
+/**
+ * @file Arduino.h
+ * @brief Stand-in of the Arduino core for the host build (env:native). Time is read from
+ *        NativeClock (host monotonic clock or virtual clock), the pins are kept in RAM and driven
+ *        by the host side functions arduinoNative_xxx(), which also call the attached interrupts.
+ *        Pin numbers of the MKR Zero.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - Arduino core stand-in of the native build (env:native)
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef void (*voidFuncPtr)(void);
+// ADC value of a host model at the current time
+typedef int (*NativeAnalogSource)(void *context);
+
+#define HIGH 0x1
+#define LOW 0x0
+
+// Pin modes
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+#define INPUT_PULLDOWN 0x3
+
+// Interrupt modes
+#define CHANGE 2
+#define FALLING 3
+#define RISING 4
+
+// Number bases of print()
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+// MKR Zero pins
+#define NUM_DIGITAL_PINS 33
+#define A0 15
+#define A1 16
+#define A2 17
+#define A3 18
+#define A4 19
+#define A5 20
+#define A6 21
+#define SDA 11
+#define SCL 12
+#define SDCARD_SS_PIN 28
+#define LED_BUILTIN 32
+
+// Resolution of analogRead() [bits]
+#define ARDUINO_NATIVE_ANALOG_BITS 10
+// Conversion time of analogRead() on the virtual clock [us]
+#define ARDUINO_NATIVE_ANALOG_TIME_US 20
+
+#define F(string) (string)
+#define digitalPinToInterrupt(pin) (pin)
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define lowByte(w) ((uint8_t)((w) & 0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+
+#include "WString.h"
+#include "Print.h"
+
+extern unsigned long millis(void);
+extern unsigned long micros(void);
+extern void delay(unsigned long ms);
+extern void delayMicroseconds(unsigned int us);
+
+extern void pinMode(uint8_t pin, uint8_t mode);
+extern void digitalWrite(uint8_t pin, uint8_t value);
+extern int digitalRead(uint8_t pin);
+extern int analogRead(uint8_t pin);
+extern void analogWrite(uint8_t pin, int value);
+extern void attachInterrupt(uint8_t interrupt, voidFuncPtr callback, int mode);
+extern void detachInterrupt(uint8_t interrupt);
+extern void noInterrupts(void);
+extern void interrupts(void);
+extern long map(long value, long fromLow, long fromHigh, long toLow, long toHigh);
+
+// Host side: level applied to an input (attached interrupts called on its edges) and analog value
+extern void arduinoNative_setPin(uint8_t pin, int value);
+extern void arduinoNative_setAnalog(uint8_t pin, int value);
+extern void arduinoNative_setAnalogSource(uint8_t pin, NativeAnalogSource source, void *context);
+// Host side: level written by the firmware to an output
+extern int arduinoNative_getPin(uint8_t pin);
+// Host side: time read without ending an idle wait of the virtual clock (measurements) [us]
+extern unsigned long arduinoNative_micros(void);
+
+// Serial port on the host standard output
+class NativeSerial : public Print{
+  public:
+    void begin(unsigned long baudrate);
+    void end(void);
+    int available(void);
+    int read(void);
+    void flush(void);
+    size_t write(uint8_t c);
+    using Print::write;
+    operator bool(){ return true; }
+};
+
+extern NativeSerial Serial;
+
+// Firmware entry points
+extern void setup(void);
+extern void loop(void);
+
+#endif
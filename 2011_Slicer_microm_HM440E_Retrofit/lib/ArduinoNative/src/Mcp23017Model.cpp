@@ -0,0 +1,258 @@
+/**
+ * @file Mcp23017Model.cpp
+ * @brief Register access of the MCP23017 model for both IOCON.BANK maps, pin levels, interrupt
+ *        capture and INTA/INTB outputs.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - register access and interrupt outputs of the MCP23017 model
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Mcp23017Model.h"
+
+// Register index in a port, address with BANK=1 (port B at +0x10), address/2 with BANK=0
+#define IODIR   0
+#define IPOL    1
+#define GPINTEN 2
+#define DEFVAL  3
+#define INTCON  4
+#define IOCON   5
+#define GPPU    6
+#define INTF    7
+#define INTCAP  8
+#define GPIO    9
+#define OLAT    10
+
+// IOCON bits
+#define IOCON_BANK   0x80
+#define IOCON_MIRROR 0x40
+#define IOCON_SEQOP  0x20
+#define IOCON_ODR    0x04
+#define IOCON_INTPOL 0x02
+
+// Register addresses of a map, BANK=0
+#define BANK0_SIZE 0x16
+
+Mcp23017Model::Mcp23017Model(uint8_t address, uint8_t intAPin, uint8_t intBPin) : address(address){
+  intPins[0] = intAPin;
+  intPins[1] = intBPin;
+  inputLevels = 0;
+  inputDriven = 0;
+  reset();
+}
+
+void Mcp23017Model::reset(void){
+  memset(registers, 0, sizeof(registers));
+  registers[0][IODIR] = 0xFF;
+  registers[1][IODIR] = 0xFF;
+  pointer = 0;
+  driveInterruptPins(true);
+}
+
+bool Mcp23017Model::acknowledge(uint8_t busAddress){
+  return busAddress == address;
+}
+
+/**
+ * @brief Register pointer then data, the pointer moves after each byte as set by IOCON.SEQOP
+ */
+bool Mcp23017Model::receive(const uint8_t *data, size_t count){
+  uint8_t previousLevels[2] = {levels(0), levels(1)};
+
+  if(!count)
+    return true;
+  pointer = data[0];
+  for(size_t i=1;i<count;i++){
+    writeRegister(pointer, data[i]);
+    pointer = nextAddress(pointer);
+  }
+  checkInterrupts(previousLevels);
+  return true;
+}
+
+size_t Mcp23017Model::request(uint8_t *data, size_t count){
+  uint8_t previousLevels[2] = {levels(0), levels(1)};
+
+  for(size_t i=0;i<count;i++){
+    data[i] = readRegister(pointer);
+    pointer = nextAddress(pointer);
+  }
+  // a mismatch with DEFVAL is signalled again as soon as the flags are cleared
+  checkInterrupts(previousLevels);
+  return count;
+}
+
+void Mcp23017Model::setInput(uint8_t pin, int level){
+  uint8_t previousLevels[2] = {levels(0), levels(1)};
+
+  if(pin > 15)
+    return;
+  inputDriven |= 1 << pin;
+  if(level)
+    inputLevels |= 1 << pin;
+  else
+    inputLevels &= ~(1 << pin);
+  checkInterrupts(previousLevels);
+}
+
+void Mcp23017Model::releaseInput(uint8_t pin){
+  uint8_t previousLevels[2] = {levels(0), levels(1)};
+
+  if(pin > 15)
+    return;
+  inputDriven &= ~(1 << pin);
+  checkInterrupts(previousLevels);
+}
+
+int Mcp23017Model::pinLevel(uint8_t pin){
+  if(pin > 15)
+    return LOW;
+  return (levels(pin >> 3) >> (pin & 0x07)) & 0x01;
+}
+
+/**
+ * @brief Levels of the pins of a port
+ *
+ * @param port 0 A, 1 B
+ * @return uint8_t levels
+ */
+uint8_t Mcp23017Model::levels(uint8_t port){
+  uint8_t *portRegisters = registers[port];
+  uint8_t driven = inputDriven >> (8*port);
+  uint8_t inputs = (inputLevels >> (8*port) & driven) | (portRegisters[GPPU] & ~driven);
+
+  return (inputs & portRegisters[IODIR]) | (portRegisters[OLAT] & ~portRegisters[IODIR]);
+}
+
+/**
+ * @brief Value read in GPIO, inputs inverted by IPOL
+ */
+uint8_t Mcp23017Model::gpioValue(uint8_t port){
+  return levels(port) ^ (registers[port][IPOL] & registers[port][IODIR]);
+}
+
+/**
+ * @brief Port and register of an address in the map selected by IOCON.BANK
+ *
+ * @return bool false if the address is not a register
+ */
+bool Mcp23017Model::decode(uint8_t registerAddress, uint8_t *port, uint8_t *index){
+  if(registers[0][IOCON] & IOCON_BANK){
+    if(registerAddress >= 0x20 || (registerAddress & 0x0F) > OLAT)
+      return false;
+    *port = registerAddress >> 4;
+    *index = registerAddress & 0x0F;
+  }else{
+    if(registerAddress >= BANK0_SIZE)
+      return false;
+    *port = registerAddress & 0x01;
+    *index = registerAddress >> 1;
+  }
+  return true;
+}
+
+/**
+ * @brief Address after an access, sequential (SEQOP=0) or byte mode: the pointer stays on the
+ *        register with BANK=1 and toggles between the A and B registers with BANK=0
+ */
+uint8_t Mcp23017Model::nextAddress(uint8_t registerAddress){
+  uint8_t iocon = registers[0][IOCON];
+
+  if(iocon & IOCON_SEQOP)
+    return iocon & IOCON_BANK ? registerAddress : registerAddress ^ 0x01;
+  if(!(iocon & IOCON_BANK))
+    return (registerAddress + 1) % BANK0_SIZE;
+  if((registerAddress & 0x0F) < OLAT)
+    return registerAddress + 1;
+  return registerAddress & 0x10 ? 0x00 : 0x10;
+}
+
+void Mcp23017Model::writeRegister(uint8_t registerAddress, uint8_t value){
+  uint8_t port, index;
+
+  if(!decode(registerAddress, &port, &index))
+    return;
+  switch(index){
+    case IOCON:
+      // one register seen in both ports
+      registers[0][IOCON] = value & 0xFE;
+      registers[1][IOCON] = value & 0xFE;
+      break;
+    case INTF:
+    case INTCAP:
+      break;
+    case GPIO:
+      registers[port][OLAT] = value;
+      break;
+    default:
+      registers[port][index] = value;
+      break;
+  }
+}
+
+uint8_t Mcp23017Model::readRegister(uint8_t registerAddress){
+  uint8_t port, index;
+
+  if(!decode(registerAddress, &port, &index))
+    return 0;
+  switch(index){
+    case GPIO:
+      registers[port][INTF] = 0;
+      return gpioValue(port);
+    case INTCAP:
+      registers[port][INTF] = 0;
+      return registers[port][INTCAP];
+    default:
+      return registers[port][index];
+  }
+}
+
+/**
+ * @brief Interrupt conditions of the enabled inputs, the port value is captured by the first one,
+ *        the next ones are ignored until the flags are cleared
+ *
+ * @param previousLevels levels of the ports before the change
+ */
+void Mcp23017Model::checkInterrupts(const uint8_t *previousLevels){
+  for(uint8_t port=0;port<2;port++){
+    uint8_t *portRegisters = registers[port];
+    uint8_t current = levels(port);
+    uint8_t enabled = portRegisters[GPINTEN] & portRegisters[IODIR];
+    uint8_t conditions = (((previousLevels[port] ^ current) & ~portRegisters[INTCON]) |
+                          ((current ^ portRegisters[DEFVAL]) & portRegisters[INTCON])) & enabled;
+
+    if(conditions && !portRegisters[INTF]){
+      portRegisters[INTF] = conditions;
+      portRegisters[INTCAP] = gpioValue(port);
+    }
+  }
+  driveInterruptPins(false);
+}
+
+/**
+ * @brief Levels of INTA and INTB, the Arduino pins are only written on a change
+ *
+ * @param force write the pins even if their level did not change
+ */
+void Mcp23017Model::driveInterruptPins(bool force){
+  uint8_t iocon = registers[0][IOCON];
+  bool active[2] = {registers[0][INTF] != 0, registers[1][INTF] != 0};
+
+  if(iocon & IOCON_MIRROR)
+    active[0] = active[1] = active[0] || active[1];
+  for(int i=0;i<2;i++){
+    int level;
+
+    // open drain: active low, released (pulled up) when inactive
+    if(iocon & IOCON_ODR)
+      level = active[i] ? LOW : HIGH;
+    else
+      level = active[i] == ((iocon & IOCON_INTPOL) != 0) ? HIGH : LOW;
+    if(intPins[i] == MCP23017_MODEL_NO_PIN || (!force && level == intLevels[i]))
+      continue;
+    intLevels[i] = level;
+    arduinoNative_setPin(intPins[i], level);
+  }
+}
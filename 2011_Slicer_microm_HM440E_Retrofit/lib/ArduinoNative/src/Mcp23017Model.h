@@ -0,0 +1,61 @@
+/**
+ * @file Mcp23017Model.h
+ * @brief Model of the MCP23017 16 bit I/O expander on the Wire stand-in (env:native). Both
+ *        register maps of IOCON.BANK (power on BANK=0) and the address pointer of IOCON.SEQOP,
+ *        pin levels from IODIR, OLAT, GPPU and IPOL, interrupts on change or against DEFVAL with
+ *        INTF/INTCAP cleared by a read of GPIO or INTCAP, and the INTA/INTB outputs (MIRROR, ODR,
+ *        INTPOL) driven on pins of the Arduino stand-in.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - MCP23017 register model of the native build
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef Mcp23017Model_h
+#define Mcp23017Model_h
+
+#include "Wire.h"
+
+// INTA/INTB output not connected
+#define MCP23017_MODEL_NO_PIN 0xFF
+
+class Mcp23017Model : public WireDevice{
+  public:
+    Mcp23017Model(uint8_t address, uint8_t intAPin = MCP23017_MODEL_NO_PIN, uint8_t intBPin = MCP23017_MODEL_NO_PIN);
+    // Power on state (reset pin)
+    void reset(void);
+
+    bool acknowledge(uint8_t address);
+    bool receive(const uint8_t *data, size_t count);
+    size_t request(uint8_t *data, size_t count);
+
+    // Host side, pins 0..15 (GPA0..GPA7, GPB0..GPB7): level applied to an input, a pin not driven
+    // by the host follows its pull-up (GPPU) or reads LOW
+    void setInput(uint8_t pin, int level);
+    void releaseInput(uint8_t pin);
+    // Host side: level of a pin, OLAT on an output
+    int pinLevel(uint8_t pin);
+
+  private:
+    uint8_t levels(uint8_t port);
+    uint8_t gpioValue(uint8_t port);
+    bool decode(uint8_t registerAddress, uint8_t *port, uint8_t *index);
+    uint8_t nextAddress(uint8_t registerAddress);
+    void writeRegister(uint8_t registerAddress, uint8_t value);
+    uint8_t readRegister(uint8_t registerAddress);
+    void checkInterrupts(const uint8_t *previousLevels);
+    void driveInterruptPins(bool force);
+
+    uint8_t address;
+    uint8_t intPins[2];
+    int intLevels[2];
+    // IODIR .. OLAT of each port, in the BANK=1 order
+    uint8_t registers[2][11];
+    uint8_t pointer;
+    uint16_t inputLevels;
+    uint16_t inputDriven;
+};
+
+#endif
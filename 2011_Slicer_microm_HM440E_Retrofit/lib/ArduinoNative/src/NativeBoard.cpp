@@ -0,0 +1,41 @@
+/**
+ * @file NativeBoard.cpp
+ * @brief Creation of the device models of the slicer and attachment to the Wire stand-in before
+ *        setup(), buttons released and limit switch not reached.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - models attached before setup()
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "NativeBoard.h"
+
+// Inputs read by main.cpp, the MCP23017 pull-ups are disabled: buttons and limit switch on
+// GPA0..GPA5 high when active, joystick on GPB0..GPB3 low when active
+#define NATIVE_BOARD_BUTTONS 6
+#define NATIVE_BOARD_JOYSTICK_FIRST 8
+#define NATIVE_BOARD_JOYSTICK_LAST 11
+// INTA and INTB of the MCP23017 on the MKR Zero (MCP23017_INTA, MCP23017_INTB of main.cpp)
+#define NATIVE_BOARD_MCP23017_INTA 1
+#define NATIVE_BOARD_MCP23017_INTB 0
+
+Pca9629aModel nativeMotor[NATIVE_BOARD_MOTORS] = {Pca9629aModel(0x20), Pca9629aModel(0x21)};
+Mcp23017Model nativeExpander(0x24, NATIVE_BOARD_MCP23017_INTA, NATIVE_BOARD_MCP23017_INTB);
+// PCF8574 ports P0..P7 to the display pins D4..D7, E, RW, RS and backlight
+Pcf8574LcdModel nativeLcd(0x27, 20, 4, 4, 5, 6, 7, 9, 10, 11, 12);
+
+/**
+ * @brief Attach the devices to the bus, buttons released and limit switch not reached
+ */
+void nativeBoard_attach(void){
+  for(int i=0;i<NATIVE_BOARD_MOTORS;i++)
+    Wire.attach(&nativeMotor[i]);
+  Wire.attach(&nativeExpander);
+  Wire.attach(&nativeLcd);
+  for(uint8_t pin=0;pin<NATIVE_BOARD_BUTTONS;pin++)
+    nativeExpander.setInput(pin, LOW);
+  for(uint8_t pin=NATIVE_BOARD_JOYSTICK_FIRST;pin<=NATIVE_BOARD_JOYSTICK_LAST;pin++)
+    nativeExpander.setInput(pin, HIGH);
+}
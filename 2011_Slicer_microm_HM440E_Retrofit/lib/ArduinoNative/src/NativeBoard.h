@@ -0,0 +1,30 @@
+/**
+ * @file NativeBoard.h
+ * @brief I2C devices of the slicer on the Wire stand-in (env:native): the PCA9629A of the 2004 board
+ *        (CONFIG_2004_01_V1.h), the MCP23017 of the buttons and leds, and the 20x4 display. They are
+ *        attached before setup(), so the drivers run unchanged on the models.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - I2C devices of the slicer on the native build
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef NativeBoard_h
+#define NativeBoard_h
+
+#include "Pca9629aModel.h"
+#include "Mcp23017Model.h"
+#include "Pcf8574LcdModel.h"
+
+// PCA9629A fitted on the board, MOTOR_A and MOTOR_B
+#define NATIVE_BOARD_MOTORS 2
+
+extern Pca9629aModel nativeMotor[NATIVE_BOARD_MOTORS];
+extern Mcp23017Model nativeExpander;
+extern Pcf8574LcdModel nativeLcd;
+
+extern void nativeBoard_attach(void);
+
+#endif
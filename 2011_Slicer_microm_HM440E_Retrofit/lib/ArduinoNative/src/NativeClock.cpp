@@ -0,0 +1,169 @@
+/**
+ * @file NativeClock.cpp
+ * @brief Host monotonic clock, virtual clock moved by the delays, transfers and idle waits, and the
+ *        time ordered queue of the model events.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - virtual clock and event queue
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "NativeClock.h"
+
+typedef struct t_nativeEvent{
+    unsigned long long time_us;
+    NativeEventFunction function;
+    void *context;
+} NATIVE_EVENT;
+
+// Events in time order, in scheduling order for the same time
+static NATIVE_EVENT events[NATIVE_CLOCK_EVENTS];
+static int eventCount = 0;
+static bool virtualClock = false;
+static unsigned long long virtualTime_us = 0;
+static unsigned int idlePolls = 0;
+// an event is running, the events it causes wait for the next dispatch
+static bool dispatching = false;
+
+/**
+ * @brief Host monotonic time since the first call
+ *
+ * @return unsigned long long time [us]
+ */
+static unsigned long long monotonic_us(void){
+  static unsigned long long start = 0;
+  struct timespec now;
+  unsigned long long time_us;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  time_us = (unsigned long long)now.tv_sec * 1000000ULL + now.tv_nsec / 1000;
+  if(!start)
+    start = time_us;
+  return time_us - start;
+}
+
+/**
+ * @brief Run the events due at a time, the virtual clock is set to the time of each event
+ *
+ * @param time_us time reached [us]
+ */
+static void runEvents(unsigned long long time_us){
+  NATIVE_EVENT event;
+
+  if(dispatching)
+    return;
+  dispatching = true;
+  while(eventCount && events[0].time_us <= time_us){
+    event = events[0];
+    eventCount--;
+    memmove(&events[0], &events[1], eventCount * sizeof(NATIVE_EVENT));
+    if(virtualClock && event.time_us > virtualTime_us)
+      virtualTime_us = event.time_us;
+    event.function(event.context);
+  }
+  dispatching = false;
+}
+
+/**
+ * @brief Move the virtual clock forward, the events on the way run at their own time
+ *
+ * @param time_us new time [us]
+ */
+static void advance(unsigned long long time_us){
+  runEvents(time_us);
+  if(time_us > virtualTime_us)
+    virtualTime_us = time_us;
+  idlePolls = 0;
+}
+
+/**
+ * @brief Switch to the virtual clock, it starts at 0 so a session is replayed identically
+ *        whatever the host time spent before. To be called before setup(), the models only
+ *        read the clock in their constructors (first host time read, also 0).
+ */
+void nativeClock_useVirtual(void){
+  if(virtualClock)
+    return;
+  virtualTime_us = 0;
+  virtualClock = true;
+}
+
+bool nativeClock_isVirtual(void){
+  return virtualClock;
+}
+
+unsigned long long nativeClock_us(void){
+  return virtualClock ? virtualTime_us : monotonic_us();
+}
+
+/**
+ * @brief Time or input read by the firmware. The due events are run, and the virtual clock
+ *        jumps when the firmware only polls (busy wait)
+ */
+void nativeClock_poll(void){
+  unsigned long long next_us;
+
+  if(!virtualClock){
+    runEvents(monotonic_us());
+    return;
+  }
+  if(dispatching || ++idlePolls < NATIVE_CLOCK_IDLE_POLLS)
+    return;
+  next_us = (virtualTime_us / NATIVE_CLOCK_IDLE_STEP_US + 1) * NATIVE_CLOCK_IDLE_STEP_US;
+  if(eventCount && events[0].time_us < next_us)
+    next_us = events[0].time_us;
+  advance(next_us);
+}
+
+void nativeClock_sleep_us(unsigned long long duration_us){
+  if(virtualClock){
+    advance(virtualTime_us + duration_us);
+    return;
+  }
+  usleep(duration_us);
+  runEvents(monotonic_us());
+}
+
+void nativeClock_spend_us(unsigned long long duration_us){
+  if(virtualClock)
+    advance(virtualTime_us + duration_us);
+}
+
+/**
+ * @brief Schedule an event
+ *
+ * @param time_us time of the event [us], an event in the past runs at the next poll
+ * @param function function run, with the context
+ * @return int 0, -1 if the queue is full
+ */
+int nativeClock_schedule(unsigned long long time_us, NativeEventFunction function, void *context){
+  int i;
+
+  if(eventCount >= NATIVE_CLOCK_EVENTS)
+    return -1;
+  for(i=eventCount;i>0 && events[i-1].time_us > time_us;i--)
+    events[i] = events[i-1];
+  events[i].time_us = time_us;
+  events[i].function = function;
+  events[i].context = context;
+  eventCount++;
+  return 0;
+}
+
+/**
+ * @brief Remove the events of a function and context not run yet
+ */
+void nativeClock_cancel(NativeEventFunction function, void *context){
+  int kept = 0;
+
+  for(int i=0;i<eventCount;i++){
+    if(events[i].function != function || events[i].context != context)
+      events[kept++] = events[i];
+  }
+  eventCount = kept;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file NativeClock.h
+ * @brief Time base of the Arduino stand-in (env:native) and discrete events of the host models.
+ *        The clock is the host monotonic clock, or a virtual clock that only moves with the
+ *        delays, the bus transfers and the idle waits: when the firmware polls the time without
+ *        anything else happening, the virtual clock jumps to the next event or to the next
+ *        millisecond (the resolution of the firmware deadlines). The events are run in time order
+ *        when the clock reaches them, as interrupts of the firmware.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - host and virtual clock of the native build
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef NativeClock_h
+#define NativeClock_h
+
+// Time polls without any progress before the virtual clock jumps (busy wait of the firmware)
+#define NATIVE_CLOCK_IDLE_POLLS 4
+// Largest jump of an idle wait [us]
+#define NATIVE_CLOCK_IDLE_STEP_US 1000
+// Events waiting in the queue
+#define NATIVE_CLOCK_EVENTS 32
+
+typedef void (*NativeEventFunction)(void *context);
+
+// Switch to the virtual clock, starting at 0 (before setup())
+extern void nativeClock_useVirtual(void);
+extern bool nativeClock_isVirtual(void);
+// Current time [us]
+extern unsigned long long nativeClock_us(void);
+// Time or input read by the firmware, ends an idle wait of the virtual clock
+extern void nativeClock_poll(void);
+// Delay of the firmware, the host sleeps with the real clock
+extern void nativeClock_sleep_us(unsigned long long duration_us);
+// Time taken by the hardware (bus transfers), only moves the virtual clock
+extern void nativeClock_spend_us(unsigned long long duration_us);
+
+// Host side: function run when the clock reaches the time, returns -1 if the queue is full
+extern int nativeClock_schedule(unsigned long long time_us, NativeEventFunction function, void *context);
+extern void nativeClock_cancel(NativeEventFunction function, void *context);
+
+#endif
@@ -0,0 +1,276 @@
+/**
+ * @file NativeSession.cpp
+ * @brief Operator of the simulated session (knob, handwheel bursts) as events of the virtual clock,
+ *        and the report of the counters at the end of the session.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - operator model of the session and final report
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stdio.h>
+#include <sys/stat.h>
+#include <time.h>
+#include "Arduino.h"
+#include "SdFat.h"
+#include "NativeClock.h"
+#include "NativeBoard.h"
+#include "NativeSession.h"
+
+// Pins of the slicer (main.cpp)
+#define SESSION_PIN_POT A2
+#define SESSION_PIN_NTC A3
+#define SESSION_PIN_NTC_HEAD A4
+#define SESSION_PIN_KNIFE A5
+#define SESSION_PIN_KNOB_SWITCH 5
+
+// Blade position on the potentiometer, top and bottom of a revolution [ADC]
+#define SESSION_POT_TOP 970
+#define SESSION_POT_BOTTOM 50
+// NTC dividers and knife input at room temperature [ADC]
+#define SESSION_NTC_VALUE 512
+
+// Knob pushes closing the homing wait and the user menu [ms]
+#define SESSION_START_PUSH_MS 2000
+#define SESSION_MENU_PUSH_MS 4000
+#define SESSION_PUSH_DURATION_MS 100
+// First burst of revolutions, the setup is done [ms]
+#define SESSION_FIRST_BURST_MS 10000
+// Screens read at the end: home screen, then the diagnostics screen shown by a knob push [ms]
+#define SESSION_HOME_SCREEN_MS 2000
+#define SESSION_DIAGNOSTICS_PUSH_MS 1500
+
+// Bursts of sections: revolutions, cadence [rev/min] and pause after the burst [s]
+#define SESSION_BURST_MIN_REV 10
+#define SESSION_BURST_MAX_REV 80
+#define SESSION_MIN_RPM 20
+#define SESSION_MAX_RPM 60
+#define SESSION_MIN_PAUSE_S 5
+#define SESSION_MAX_PAUSE_S 120
+// Seed of the bursts, the same session is replayed on each run
+#define SESSION_SEED 0x2011
+
+#define SESSION_LCD_ROWS 4
+#define SESSION_LCD_COLUMNS 20
+
+// Handwheel turned by the operator, the bursts are drawn when the time reaches them
+typedef struct t_sessionHandwheel{
+    unsigned long long burstStart_us;
+    unsigned long long burstEnd_us;
+    unsigned long long nextBurst_us;
+    unsigned long long period_us;               // one revolution
+    unsigned long burstRevolutions;
+    unsigned long revolutions;                  // revolutions of the finished bursts
+    unsigned long bursts;
+    uint32_t random;
+} SESSION_HANDWHEEL;
+
+static bool sessionActive = false;
+static bool sessionFinished = false;
+static unsigned long long sessionEnd_us;
+static struct timespec hostStart;
+static SESSION_HANDWHEEL handwheel;
+static char homeScreen[SESSION_LCD_ROWS][SESSION_LCD_COLUMNS + 1];
+static char diagnosticsScreen[SESSION_LCD_ROWS][SESSION_LCD_COLUMNS + 1];
+
+// Config of the session card, written if the card has none (six users as MAX_USER_SETTINGS)
+static const char sessionConfig[] =
+  "{\n"
+  "  \"General\": {\n"
+  "    \"BacklashCW_correction\": 50,\n"
+  "    \"BacklashCCW_correction\": 50,\n"
+  "    \"HomingSpeed\": 20,\n"
+  "    \"MovingSpeed\": 100,\n"
+  "    \"ScreenBacklight\": \"on\",\n"
+  "    \"DriveMode\": \"full\",\n"
+  "    \"PredictLead_ms\": 5,\n"
+  "    \"PotFilter\": \"median\",\n"
+  "    \"NtcFilter\": \"average\"\n"
+  "  },\n"
+  "  \"UsersSettings\": [\n"
+  "%s"
+  "  ]\n"
+  "}\n";
+static const char sessionUser[] =
+  "    {\n"
+  "      \"Name\": \"session%d\",\n"
+  "      \"DefaultThicknessMode\": \"normal\",\n"
+  "      \"thicknessNormal_um\": 10,\n"
+  "      \"thicknessTrimm_um\": 50,\n"
+  "      \"thresholdToRewind\": 600,\n"
+  "      \"thresholdToCut\": 400,\n"
+  "      \"TempAlarmState\": \"off\",\n"
+  "      \"TemperatureAlarm\": 40\n"
+  "    }%s\n";
+#define SESSION_USERS 6
+
+/**
+ * @brief Pseudo random value in a range (linear congruential generator)
+ */
+static unsigned long randomRange(unsigned long low, unsigned long high){
+  handwheel.random = handwheel.random * 1103515245UL + 12345UL;
+  return low + (handwheel.random >> 8) % (high - low + 1);
+}
+
+/**
+ * @brief Next burst of revolutions, after the pause of the previous one
+ */
+static void nextBurst(void){
+  unsigned long rpm = randomRange(SESSION_MIN_RPM, SESSION_MAX_RPM);
+
+  if(handwheel.bursts)
+    handwheel.revolutions += handwheel.burstRevolutions;
+  handwheel.bursts++;
+  handwheel.burstStart_us = handwheel.nextBurst_us;
+  handwheel.burstRevolutions = randomRange(SESSION_BURST_MIN_REV, SESSION_BURST_MAX_REV);
+  handwheel.period_us = 60000000ULL / rpm;
+  handwheel.burstEnd_us = handwheel.burstStart_us + handwheel.burstRevolutions * handwheel.period_us;
+  handwheel.nextBurst_us = handwheel.burstEnd_us + randomRange(SESSION_MIN_PAUSE_S, SESSION_MAX_PAUSE_S) * 1000000ULL;
+}
+
+/**
+ * @brief Blade position at the current time, the handwheel rests with the blade at the top
+ *        between the bursts
+ */
+static int handwheelPosition(void *context){
+  unsigned long long now_us = nativeClock_us();
+  double phase;
+
+  (void)context;
+  while(now_us >= handwheel.nextBurst_us)
+    nextBurst();
+  if(!handwheel.bursts || now_us >= handwheel.burstEnd_us)
+    return SESSION_POT_TOP;
+  phase = (double)((now_us - handwheel.burstStart_us) % handwheel.period_us) / handwheel.period_us;
+  return (SESSION_POT_TOP + SESSION_POT_BOTTOM) / 2 + (SESSION_POT_TOP - SESSION_POT_BOTTOM) / 2 * cos(2 * M_PI * phase);
+}
+
+/**
+ * @brief Revolutions of the handwheel done at the current time
+ */
+static unsigned long handwheelRevolutions(void){
+  unsigned long long now_us = nativeClock_us();
+
+  if(!handwheel.bursts)
+    return 0;
+  if(now_us >= handwheel.burstEnd_us)
+    return handwheel.revolutions + handwheel.burstRevolutions;
+  return handwheel.revolutions + (now_us - handwheel.burstStart_us) / handwheel.period_us;
+}
+
+static void knobPress(void *context){
+  (void)context;
+  arduinoNative_setPin(SESSION_PIN_KNOB_SWITCH, LOW);
+}
+
+static void knobRelease(void *context){
+  (void)context;
+  arduinoNative_setPin(SESSION_PIN_KNOB_SWITCH, HIGH);
+}
+
+/**
+ * @brief Short push of the knob
+ *
+ * @param time_us start of the push [us]
+ */
+static void scheduleKnobPush(unsigned long long time_us){
+  nativeClock_schedule(time_us, knobPress, NULL);
+  nativeClock_schedule(time_us + SESSION_PUSH_DURATION_MS * 1000ULL, knobRelease, NULL);
+}
+
+/**
+ * @brief Copy of the rows shown by the display
+ *
+ * @param context SESSION_LCD_ROWS rows of SESSION_LCD_COLUMNS + 1 characters
+ */
+static void readScreen(void *context){
+  char (*screen)[SESSION_LCD_COLUMNS + 1] = (char (*)[SESSION_LCD_COLUMNS + 1])context;
+
+  for(uint8_t row=0;row<SESSION_LCD_ROWS;row++)
+    nativeLcd.row(row, screen[row]);
+}
+
+static void endSession(void *context){
+  readScreen(context);
+  sessionFinished = true;
+}
+
+/**
+ * @brief Config of the session on the card, a config already on the card is kept
+ */
+static void writeConfig(void){
+  const char *root = getenv("SDFAT_NATIVE_ROOT");
+  char users[sizeof(sessionUser) * SESSION_USERS + 64];
+  char config[sizeof(sessionConfig) + sizeof(users)];
+  size_t length = 0;
+  SdFat card;
+  File file;
+
+  mkdir(root ? root : SDFAT_NATIVE_ROOT, 0755);
+  if(!card.begin(SDCARD_SS_PIN) || card.exists("config.cfg"))
+    return;
+  for(int i=0;i<SESSION_USERS;i++)
+    length += snprintf(users + length, sizeof(users) - length, sessionUser, i, i < SESSION_USERS - 1 ? "," : "");
+  file = card.open("config.cfg", FILE_WRITE);
+  if(!file)
+    return;
+  length = snprintf(config, sizeof(config), sessionConfig, users);
+  file.write((const uint8_t *)config, length);
+  file.close();
+}
+
+bool nativeSession_begin(void){
+  const char *hours = getenv(NATIVE_SESSION_ENV);
+  unsigned long long duration_us;
+
+  if(!hours || atof(hours) <= 0)
+    return false;
+  nativeClock_useVirtual();
+  clock_gettime(CLOCK_MONOTONIC, &hostStart);
+  duration_us = (unsigned long long)(atof(hours) * 3600e6);
+  sessionEnd_us = nativeClock_us() + duration_us;
+  sessionActive = true;
+  writeConfig();
+  arduinoNative_setAnalog(SESSION_PIN_NTC, SESSION_NTC_VALUE);
+  arduinoNative_setAnalog(SESSION_PIN_NTC_HEAD, SESSION_NTC_VALUE);
+  arduinoNative_setAnalog(SESSION_PIN_KNIFE, SESSION_NTC_VALUE);
+  handwheel.random = SESSION_SEED;
+  handwheel.nextBurst_us = nativeClock_us() + SESSION_FIRST_BURST_MS * 1000ULL;
+  arduinoNative_setAnalogSource(SESSION_PIN_POT, handwheelPosition, NULL);
+  arduinoNative_setPin(SESSION_PIN_KNOB_SWITCH, HIGH);
+  scheduleKnobPush(nativeClock_us() + SESSION_START_PUSH_MS * 1000ULL);
+  scheduleKnobPush(nativeClock_us() + SESSION_MENU_PUSH_MS * 1000ULL);
+  nativeClock_schedule(sessionEnd_us - SESSION_HOME_SCREEN_MS * 1000ULL, readScreen, homeScreen);
+  scheduleKnobPush(sessionEnd_us - SESSION_DIAGNOSTICS_PUSH_MS * 1000ULL);
+  nativeClock_schedule(sessionEnd_us, endSession, diagnosticsScreen);
+  return true;
+}
+
+bool nativeSession_finished(void){
+  return sessionFinished;
+}
+
+/**
+ * @brief Screens and counters at the end of the session, to compare runs of two builds
+ *
+ * @return int 0, 1 if the display missed instructions or data
+ */
+int nativeSession_report(void){
+  struct timespec hostEnd;
+  double hostTime;
+
+  if(!sessionActive)
+    return 0;
+  clock_gettime(CLOCK_MONOTONIC, &hostEnd);
+  hostTime = (hostEnd.tv_sec - hostStart.tv_sec) + (hostEnd.tv_nsec - hostStart.tv_nsec) / 1e9;
+  printf("\nsession: %.2f h simulated in %.1f s\n", nativeClock_us() / 3600e6, hostTime);
+  printf("handwheel: %lu revolutions in %lu bursts\n", handwheelRevolutions(), handwheel.bursts);
+  for(int i=0;i<NATIVE_BOARD_MOTORS;i++)
+    printf("motor %c: position %ld steps\n", 'A' + i, nativeMotor[i].stepCount());
+  printf("display: %lu writes while busy\n", nativeLcd.busyViolations());
+  for(uint8_t row=0;row<SESSION_LCD_ROWS;row++)
+    printf("|%s|  |%s|\n", homeScreen[row], diagnosticsScreen[row]);
+  return nativeLcd.busyViolations() ? 1 : 0;
+}
@@ -0,0 +1,29 @@
+/**
+ * @file NativeSession.h
+ * @brief Simulated sectioning session of the native build (env:native) on the virtual clock of
+ *        NativeClock. The ARDUINO_NATIVE_SESSION environment variable gives its duration in hours:
+ *        the knob closes the homing wait and the user menu, the handwheel turned by the operator
+ *        drives the blade position in bursts of revolutions at a varying cadence, and the
+ *        counters of the firmware and of the models are printed at the end.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - sessions of the native build on the virtual clock
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef NativeSession_h
+#define NativeSession_h
+
+#define NATIVE_SESSION_ENV "ARDUINO_NATIVE_SESSION"
+
+// Virtual clock and session events when ARDUINO_NATIVE_SESSION is set, returns false otherwise
+extern bool nativeSession_begin(void);
+// Session duration reached, always false without a session
+extern bool nativeSession_finished(void);
+// Prints the screens and the counters of the session, exit code of the host program.
+// tools/session_compare.py checks the report against tools/session_golden.txt
+extern int nativeSession_report(void);
+
+#endif
@@ -0,0 +1,213 @@
+/**
+ * @file Pca9629aModel.cpp
+ * @brief Register access of the PCA9629A model and motor actions of MCNTL, the motor position is
+ *        brought to the current time at each access.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - register access and motor actions of the PCA9629A model
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Pca9629aModel.h"
+
+// Registers
+#define MODE        0x00
+#define IP          0x07
+#define PMA         0x0F
+#define CWSCOUNTL   0x12
+#define CCWSCOUNTL  0x14
+#define CWPWL       0x16
+#define CCWPWL      0x18
+#define MCNTL       0x1A
+#define SUBA1       0x1B
+#define STEPCOUNT0  0x1F
+
+// MODE bits enabling the sub-addresses 1..3 and the all call address
+static const uint8_t subAddressEnable[] = {0x08, 0x04, 0x02, 0x01};
+
+// MCNTL bits, START stays set while the action runs, RESTART and EMERGENCY STOP are self-clearing
+#define MCNTL_START     0x80
+#define MCNTL_RESTART   0x40
+#define MCNTL_EMERGENCY 0x20
+#define MCNTL_ROTDIR    0x03        // 0 CW, 1 CCW, 2 CW then CCW, 3 CCW then CW
+
+// Power on values, MODE .. STEPCOUNT3
+static const uint8_t resetValues[PCA9629A_MODEL_REGISTERS] = {
+  0x20, 0xFF, 0x00, 0x0F, 0x00, 0x1F, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE2, 0xE4, 0xE8, 0xE0, 0x00,
+  0x00, 0x00, 0x00
+};
+
+Pca9629aModel::Pca9629aModel(uint8_t address) : address(address){
+  reset();
+}
+
+void Pca9629aModel::reset(void){
+  memcpy(registers, resetValues, sizeof(registers));
+  pointer = 0;
+  moveDirection = 0;
+  secondMove = false;
+  stepsLeft = 0;
+  period_us = 1;
+  lastStep_us = 0;
+  actionsLeft = 0;
+  steps = 0;
+}
+
+bool Pca9629aModel::acknowledge(uint8_t busAddress){
+  if(busAddress == address)
+    return true;
+  // sub-addresses and all call address are in the 8 bit format
+  for(int i=0;i<4;i++){
+    if((registers[MODE] & subAddressEnable[i]) && (registers[SUBA1 + i] >> 1) == busAddress)
+      return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Register pointer then data, the pointer is incremented after each byte
+ *
+ * @return bool false if the register pointer is out of the register file
+ */
+bool Pca9629aModel::receive(const uint8_t *data, size_t count){
+  update();
+  if(!count)
+    return true;
+  if(data[0] >= PCA9629A_MODEL_REGISTERS)
+    return false;
+  pointer = data[0];
+  for(size_t i=1;i<count;i++){
+    if(pointer == MCNTL)
+      control(data[i]);
+    else if(pointer != IP && pointer < STEPCOUNT0)
+      registers[pointer] = data[i];    // input port and STEPCOUNT are read only
+    pointer = (pointer + 1) % PCA9629A_MODEL_REGISTERS;
+  }
+  return true;
+}
+
+size_t Pca9629aModel::request(uint8_t *data, size_t count){
+  update();
+  for(size_t i=0;i<count;i++){
+    data[i] = registers[pointer];
+    pointer = (pointer + 1) % PCA9629A_MODEL_REGISTERS;
+  }
+  return count;
+}
+
+long Pca9629aModel::stepCount(void){
+  update();
+  return steps;
+}
+
+int Pca9629aModel::direction(void){
+  update();
+  return moveDirection;
+}
+
+uint8_t Pca9629aModel::reg(uint8_t registerAddress){
+  update();
+  return registerAddress < PCA9629A_MODEL_REGISTERS ? registers[registerAddress] : 0;
+}
+
+/**
+ * @brief Steps of the running action up to the current time, the next move is loaded from the
+ *        registers when the previous one ends, as on the device
+ */
+void Pca9629aModel::update(void){
+  unsigned long now_us = micros();
+  unsigned long stepsDue;
+  int emptyMoves = 0;
+
+  while(moveDirection){
+    if(!stepsLeft){
+      // an action without steps would never end in the continuous mode
+      if(++emptyMoves > 2){
+        stop();
+        break;
+      }
+      endMove();
+      continue;
+    }
+    emptyMoves = 0;
+    stepsDue = (now_us - lastStep_us) / period_us;
+    if(!stepsDue)
+      break;
+    if(stepsDue > stepsLeft)
+      stepsDue = stepsLeft;
+    steps += moveDirection * (long)stepsDue;
+    stepsLeft -= stepsDue;
+    lastStep_us += stepsDue * period_us;
+  }
+  for(int i=0;i<4;i++)
+    registers[STEPCOUNT0 + i] = ((unsigned long)steps >> (8*i)) & 0xFF;
+}
+
+/**
+ * @brief Write of the motor control register
+ *
+ * @param value MCNTL
+ */
+void Pca9629aModel::control(uint8_t value){
+  registers[MCNTL] = value & ~(MCNTL_RESTART | MCNTL_EMERGENCY);
+  if(value & MCNTL_EMERGENCY){
+    stop();
+    return;
+  }
+  if(!(value & MCNTL_START)){
+    stop();
+    return;
+  }
+  if(moveDirection && !(value & MCNTL_RESTART))
+    return;
+  lastStep_us = micros();
+  actionsLeft = registers[PMA];
+  secondMove = false;
+  startMove(value & 0x01 ? -1 : 1);
+}
+
+/**
+ * @brief Load the steps and the period of a move from the registers of its direction
+ *
+ * @param direction 1 CW, -1 CCW
+ */
+void Pca9629aModel::startMove(int direction){
+  uint16_t pulseWidth = word(direction > 0 ? CWPWL : CCWPWL);
+
+  moveDirection = direction;
+  stepsLeft = word(direction > 0 ? CWSCOUNTL : CCWSCOUNTL);
+  // 3us time base, prescaler in the 3 most significant bits
+  period_us = (3UL << (pulseWidth >> 13)) * ((pulseWidth & 0x1FFF) + 1);
+}
+
+/**
+ * @brief Next move of the action, next action, or end of the actions
+ */
+void Pca9629aModel::endMove(void){
+  uint8_t rotationDirection = registers[MCNTL] & MCNTL_ROTDIR;
+
+  if((rotationDirection & 0x02) && !secondMove){
+    secondMove = true;
+    startMove(-moveDirection);
+    return;
+  }
+  if(actionsLeft && !--actionsLeft){
+    stop();
+    return;
+  }
+  secondMove = false;
+  startMove(rotationDirection & 0x01 ? -1 : 1);
+}
+
+void Pca9629aModel::stop(void){
+  moveDirection = 0;
+  stepsLeft = 0;
+  registers[MCNTL] &= ~MCNTL_START;
+}
+
+uint16_t Pca9629aModel::word(uint8_t lowAddress){
+  return registers[lowAddress] | (registers[lowAddress + 1] << 8);
+}
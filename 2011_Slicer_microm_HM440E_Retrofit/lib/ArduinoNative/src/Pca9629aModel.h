@@ -0,0 +1,62 @@
+/**
+ * @file Pca9629aModel.h
+ * @brief Model of the PCA9629A stepper motor controller on the Wire stand-in (env:native). The
+ *        register file (auto-incremented pointer), the sub-addresses and all call address of the
+ *        MODE register, and the motor actions of MCNTL: CWSCOUNT/CCWSCOUNT steps at the period of
+ *        CWPW/CCWPW, ROTDIR sequences repeated PMA times (0 = continuous), STEPCOUNT. The motor is
+ *        moved lazily to the current time at each access. Ramps, loop delays and the INT output
+ *        are not modelled.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - PCA9629A register model of the native build
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef Pca9629aModel_h
+#define Pca9629aModel_h
+
+#include "Wire.h"
+
+// Registers MODE (0x00) to STEPCOUNT3 (0x22)
+#define PCA9629A_MODEL_REGISTERS 0x23
+
+class Pca9629aModel : public WireDevice{
+  public:
+    Pca9629aModel(uint8_t address);
+    // Power on state of the registers, motor stopped
+    void reset(void);
+
+    bool acknowledge(uint8_t address);
+    bool receive(const uint8_t *data, size_t count);
+    size_t request(uint8_t *data, size_t count);
+
+    // Host side, at the current time: steps since the reset (CW positive), direction of the
+    // running move (1 CW, -1 CCW, 0 stopped) and register value
+    long stepCount(void);
+    int direction(void);
+    uint8_t reg(uint8_t address);
+
+  private:
+    void update(void);
+    void control(uint8_t value);
+    void startMove(int moveDirection);
+    void endMove(void);
+    void stop(void);
+    uint16_t word(uint8_t address);
+
+    uint8_t address;
+    uint8_t registers[PCA9629A_MODEL_REGISTERS];
+    uint8_t pointer;
+    // running move
+    int moveDirection;
+    bool secondMove;                // second move of a CW then CCW or CCW then CW action
+    unsigned long stepsLeft;
+    unsigned long period_us;
+    unsigned long lastStep_us;      // time of the last step, or of the start of the move
+    unsigned int actionsLeft;       // 0 continuous
+    long steps;
+};
+
+#endif
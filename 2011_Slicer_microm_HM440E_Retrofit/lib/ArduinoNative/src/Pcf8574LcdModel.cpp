@@ -0,0 +1,302 @@
+/**
+ * @file Pcf8574LcdModel.cpp
+ * @brief PCF8574 port to display pin mapping, nibble assembly on the falling edge of E, and the
+ *        HD44780 instructions with their busy time.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - port to display pin mapping and HD44780 instructions
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Pcf8574LcdModel.h"
+
+// Instructions, highest bit set gives the instruction
+#define LCD_CLEAR           0x01
+#define LCD_HOME            0x02
+#define LCD_ENTRY_MODE      0x04
+#define LCD_DISPLAY_CONTROL 0x08
+#define LCD_SHIFT           0x10
+#define LCD_FUNCTION_SET    0x20
+#define LCD_CGRAM_ADDRESS   0x40
+#define LCD_DDRAM_ADDRESS   0x80
+
+// Execution times [us] (270kHz oscillator), the data write includes the address update
+#define LCD_CLEAR_TIME_US 1520
+#define LCD_INSTRUCTION_TIME_US 37
+#define LCD_DATA_TIME_US 41
+
+// Second line of the DDRAM in the two lines mode
+#define LCD_LINE2_ADDRESS 0x40
+
+Pcf8574LcdModel::Pcf8574LcdModel(uint8_t address, uint8_t columns, uint8_t rows, uint8_t P0, uint8_t P1, uint8_t P2, uint8_t P3, uint8_t P4, uint8_t P5, uint8_t P6, uint8_t P7)
+  : address(address), columns(columns), rows(rows){
+  const uint8_t portToLcd[8] = {P0, P1, P2, P3, P4, P5, P6, P7};
+
+  if(this->columns > LCD_MODEL_MAX_COLUMNS)
+    this->columns = LCD_MODEL_MAX_COLUMNS;
+  if(this->rows > 4)
+    this->rows = 4;
+  memset(portMask, 0, sizeof(portMask));
+  for(int i=0;i<8;i++){
+    if(portToLcd[i] <= LCD_MODEL_PIN_BL)
+      portMask[portToLcd[i]] = 1 << i;
+  }
+  violations = 0;
+  reset();
+}
+
+void Pcf8574LcdModel::reset(void){
+  // PCF8574 ports high at power on
+  portLevels = 0xFF;
+  memset(ddram, ' ', sizeof(ddram));
+  memset(cgram, 0, sizeof(cgram));
+  addressCounter = 0;
+  cgramSelected = false;
+  fourBits = false;
+  twoLines = false;
+  secondNibble = false;
+  highNibble = 0;
+  increment = true;
+  shiftDisplay = false;
+  displayControl = 0;
+  shift = 0;
+  busyStart_us = micros();
+  busyTime_us = 0;
+}
+
+bool Pcf8574LcdModel::acknowledge(uint8_t busAddress){
+  return busAddress == address;
+}
+
+/**
+ * @brief Each byte written sets the PCF8574 ports
+ */
+bool Pcf8574LcdModel::receive(const uint8_t *data, size_t count){
+  for(size_t i=0;i<count;i++)
+    latch(data[i]);
+  return true;
+}
+
+/**
+ * @brief Quasi-bidirectional ports: a port written high is read low when the display pulls it
+ *        down, the display drives D7..D4 while E is high on a read (RW high)
+ */
+size_t Pcf8574LcdModel::request(uint8_t *data, size_t count){
+  uint8_t levels = portLevels;
+
+  if((portLevels & pin(LCD_MODEL_PIN_E)) && (portLevels & pin(LCD_MODEL_PIN_RW))){
+    uint8_t value = readValue(portLevels & pin(LCD_MODEL_PIN_RS));
+    uint8_t nibble = fourBits && secondNibble ? value & 0x0F : value >> 4;
+
+    for(int i=0;i<4;i++){
+      if(!(nibble & (1 << i)))
+        levels &= ~pin(LCD_MODEL_PIN_D4 + i);
+    }
+  }
+  for(size_t i=0;i<count;i++)
+    data[i] = levels;
+  return count;
+}
+
+void Pcf8574LcdModel::row(uint8_t rowIndex, char *text){
+  uint8_t column;
+
+  for(column=0;column<columns;column++){
+    uint8_t code = character(column, rowIndex);
+    text[column] = code < 0x10 ? '*' : code;
+  }
+  text[column] = 0;
+}
+
+/**
+ * @brief Character code shown at a position, the rows 2 and 3 continue the lines of the rows 0
+ *        and 1 (DDRAM 0x14 and 0x54 on a 20x4 display)
+ */
+uint8_t Pcf8574LcdModel::character(uint8_t column, uint8_t rowIndex){
+  uint8_t lineLength = twoLines ? LCD_MODEL_DDRAM_SIZE / 2 : LCD_MODEL_DDRAM_SIZE;
+  uint8_t line = twoLines ? rowIndex & 0x01 : 0;
+  uint8_t offset = rowIndex >= 2 ? columns : 0;
+
+  if(column >= columns || rowIndex >= rows)
+    return ' ';
+  return ddram[line * lineLength + (offset + column + shift) % lineLength];
+}
+
+bool Pcf8574LcdModel::displayOn(void){
+  return displayControl & 0x04;
+}
+
+bool Pcf8574LcdModel::backlight(void){
+  return portLevels & pin(LCD_MODEL_PIN_BL);
+}
+
+unsigned long Pcf8574LcdModel::busyViolations(void){
+  return violations;
+}
+
+/**
+ * @brief PCF8574 port bit of a display pin
+ */
+uint8_t Pcf8574LcdModel::pin(uint8_t lcdPin){
+  return portMask[lcdPin];
+}
+
+/**
+ * @brief New levels of the PCF8574 ports, the display takes D7..D4 on the falling edge of E
+ *
+ * @param port byte written to the PCF8574
+ */
+void Pcf8574LcdModel::latch(uint8_t port){
+  uint8_t previous = portLevels;
+  uint8_t nibble = 0;
+
+  portLevels = port;
+  if(!(previous & pin(LCD_MODEL_PIN_E)) || (port & pin(LCD_MODEL_PIN_E)))
+    return;
+  for(int i=0;i<4;i++){
+    if(previous & pin(LCD_MODEL_PIN_D4 + i))
+      nibble |= 1 << i;
+  }
+  if(previous & pin(LCD_MODEL_PIN_RW)){
+    // read: the address counter moves after a data read
+    if(fourBits && !secondNibble){
+      secondNibble = true;
+      return;
+    }
+    secondNibble = false;
+    if(previous & pin(LCD_MODEL_PIN_RS))
+      moveAddress(increment ? 1 : -1);
+    return;
+  }
+  // 8 bit interface: D3..D0 are not connected and read low
+  if(!fourBits){
+    execute(previous & pin(LCD_MODEL_PIN_RS), nibble << 4);
+    return;
+  }
+  if(!secondNibble){
+    highNibble = nibble;
+    secondNibble = true;
+    return;
+  }
+  secondNibble = false;
+  execute(previous & pin(LCD_MODEL_PIN_RS), (highNibble << 4) | nibble);
+}
+
+/**
+ * @brief Instruction or data written to the display
+ *
+ * @param data true for a data write (RS high)
+ * @param value instruction or data
+ */
+void Pcf8574LcdModel::execute(bool data, uint8_t value){
+  unsigned long now_us = micros();
+
+  if(now_us - busyStart_us < busyTime_us)
+    violations++;
+  busyStart_us = now_us;
+  if(!data){
+    busyTime_us = value == LCD_CLEAR || (value & 0xFE) == LCD_HOME ? LCD_CLEAR_TIME_US : LCD_INSTRUCTION_TIME_US;
+    instruction(value);
+    return;
+  }
+  busyTime_us = LCD_DATA_TIME_US;
+  if(cgramSelected){
+    cgram[addressCounter & (LCD_MODEL_CGRAM_SIZE - 1)] = value;
+  }else{
+    uint8_t index = ddramIndex(addressCounter);
+
+    if(index < LCD_MODEL_DDRAM_SIZE)
+      ddram[index] = value;
+    if(shiftDisplay)
+      shift = (shift + (increment ? 1 : -1) + LCD_MODEL_DDRAM_SIZE) % (twoLines ? LCD_MODEL_DDRAM_SIZE / 2 : LCD_MODEL_DDRAM_SIZE);
+  }
+  moveAddress(increment ? 1 : -1);
+}
+
+void Pcf8574LcdModel::instruction(uint8_t value){
+  uint8_t lineLength = twoLines ? LCD_MODEL_DDRAM_SIZE / 2 : LCD_MODEL_DDRAM_SIZE;
+
+  if(value & LCD_DDRAM_ADDRESS){
+    addressCounter = value & 0x7F;
+    cgramSelected = false;
+  }else if(value & LCD_CGRAM_ADDRESS){
+    addressCounter = value & 0x3F;
+    cgramSelected = true;
+  }else if(value & LCD_FUNCTION_SET){
+    fourBits = !(value & 0x10);
+    twoLines = value & 0x08;
+    secondNibble = false;
+  }else if(value & LCD_SHIFT){
+    // display shift (S/C) or cursor move, to the right with R/L
+    if(value & 0x08)
+      shift = (shift + (value & 0x04 ? lineLength - 1 : 1)) % lineLength;
+    else
+      moveAddress(value & 0x04 ? 1 : -1);
+  }else if(value & LCD_DISPLAY_CONTROL){
+    displayControl = value & 0x07;
+  }else if(value & LCD_ENTRY_MODE){
+    increment = value & 0x02;
+    shiftDisplay = value & 0x01;
+  }else if(value & LCD_HOME){
+    addressCounter = 0;
+    cgramSelected = false;
+    shift = 0;
+  }else if(value & LCD_CLEAR){
+    memset(ddram, ' ', sizeof(ddram));
+    addressCounter = 0;
+    cgramSelected = false;
+    increment = true;
+    shift = 0;
+  }
+}
+
+/**
+ * @brief Busy flag and address counter (RS low) or data at the address counter (RS high)
+ */
+uint8_t Pcf8574LcdModel::readValue(bool data){
+  uint8_t index;
+
+  if(!data)
+    return (micros() - busyStart_us < busyTime_us ? 0x80 : 0x00) | addressCounter;
+  if(cgramSelected)
+    return cgram[addressCounter & (LCD_MODEL_CGRAM_SIZE - 1)];
+  index = ddramIndex(addressCounter);
+  return index < LCD_MODEL_DDRAM_SIZE ? ddram[index] : ' ';
+}
+
+/**
+ * @brief Next address of the counter, the DDRAM lines wrap to each other
+ *
+ * @param step 1 or -1
+ */
+void Pcf8574LcdModel::moveAddress(int step){
+  int index;
+
+  if(cgramSelected){
+    addressCounter = (addressCounter + step) & (LCD_MODEL_CGRAM_SIZE - 1);
+    return;
+  }
+  index = ddramIndex(addressCounter);
+  if(index >= LCD_MODEL_DDRAM_SIZE)
+    index = 0;
+  index = (index + step + LCD_MODEL_DDRAM_SIZE) % LCD_MODEL_DDRAM_SIZE;
+  if(twoLines && index >= LCD_MODEL_DDRAM_SIZE / 2)
+    addressCounter = LCD_LINE2_ADDRESS + index - LCD_MODEL_DDRAM_SIZE / 2;
+  else
+    addressCounter = index;
+}
+
+/**
+ * @brief Index in the DDRAM of an address, LCD_MODEL_DDRAM_SIZE if the address is not used
+ */
+uint8_t Pcf8574LcdModel::ddramIndex(uint8_t ddramAddress){
+  if(!twoLines)
+    return ddramAddress < LCD_MODEL_DDRAM_SIZE ? ddramAddress : LCD_MODEL_DDRAM_SIZE;
+  if(ddramAddress < LCD_MODEL_DDRAM_SIZE / 2)
+    return ddramAddress;
+  if(ddramAddress >= LCD_LINE2_ADDRESS && ddramAddress < LCD_LINE2_ADDRESS + LCD_MODEL_DDRAM_SIZE / 2)
+    return ddramAddress - LCD_LINE2_ADDRESS + LCD_MODEL_DDRAM_SIZE / 2;
+  return LCD_MODEL_DDRAM_SIZE;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file Pcf8574LcdModel.h
+ * @brief Model of an HD44780 character display behind a PCF8574 I2C backpack on the Wire stand-in
+ *        (env:native). The PCF8574 ports are mapped to the display pins as in the LiquidCrystal_I2C
+ *        constructor, the HD44780 latches the data lines on the falling edge of E: 8 bit interface
+ *        at power on, 4 bit interface (two nibbles) after a function set, the instruction set, the
+ *        DDRAM (two lines of 40 characters) and the CGRAM, and the busy time of the instructions.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - HD44780 and PCF8574 model of the native build
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef Pcf8574LcdModel_h
+#define Pcf8574LcdModel_h
+
+#include "Wire.h"
+
+// Display pins connected to the PCF8574 ports (numbering of the LiquidCrystal_I2C constructor)
+#define LCD_MODEL_PIN_D4 4
+#define LCD_MODEL_PIN_D5 5
+#define LCD_MODEL_PIN_D6 6
+#define LCD_MODEL_PIN_D7 7
+#define LCD_MODEL_PIN_E  9
+#define LCD_MODEL_PIN_RW 10
+#define LCD_MODEL_PIN_RS 11
+#define LCD_MODEL_PIN_BL 12
+
+// Size of the display memories
+#define LCD_MODEL_DDRAM_SIZE 80
+#define LCD_MODEL_CGRAM_SIZE 64
+#define LCD_MODEL_MAX_COLUMNS 40
+
+class Pcf8574LcdModel : public WireDevice{
+  public:
+    // P0..P7 display pin on each PCF8574 port
+    Pcf8574LcdModel(uint8_t address, uint8_t columns, uint8_t rows, uint8_t P0, uint8_t P1, uint8_t P2, uint8_t P3, uint8_t P4, uint8_t P5, uint8_t P6, uint8_t P7);
+    // Power on state, 8 bit interface, display off
+    void reset(void);
+
+    bool acknowledge(uint8_t address);
+    bool receive(const uint8_t *data, size_t count);
+    size_t request(uint8_t *data, size_t count);
+
+    // Host side: character codes shown on a row (columns + 1 bytes with the terminating 0), the
+    // CGRAM characters 0..15 are given as '*'
+    void row(uint8_t rowIndex, char *text);
+    uint8_t character(uint8_t column, uint8_t rowIndex);
+    bool displayOn(void);
+    bool backlight(void);
+    // Instructions and data received while the display was busy (lost on a real display)
+    unsigned long busyViolations(void);
+
+  private:
+    uint8_t pin(uint8_t lcdPin);
+    void latch(uint8_t port);
+    void execute(bool data, uint8_t value);
+    void instruction(uint8_t value);
+    uint8_t readValue(bool data);
+    void moveAddress(int step);
+    uint8_t ddramIndex(uint8_t ddramAddress);
+
+    uint8_t address;
+    uint8_t columns;
+    uint8_t rows;
+    uint8_t portMask[LCD_MODEL_PIN_BL + 1];     // PCF8574 port bit of each display pin
+    uint8_t portLevels;                         // last byte written to the PCF8574
+    uint8_t ddram[LCD_MODEL_DDRAM_SIZE];
+    uint8_t cgram[LCD_MODEL_CGRAM_SIZE];
+    uint8_t addressCounter;
+    bool cgramSelected;
+    bool fourBits;
+    bool twoLines;
+    bool secondNibble;                          // 4 bit interface, the high nibble was received
+    uint8_t highNibble;
+    bool increment;                             // entry mode I/D
+    bool shiftDisplay;                          // entry mode S
+    uint8_t displayControl;                     // display on, cursor, blink
+    uint8_t shift;                              // display shift, 0..39
+    unsigned long busyStart_us;
+    unsigned long busyTime_us;
+    unsigned long violations;
+};
+
+#endif
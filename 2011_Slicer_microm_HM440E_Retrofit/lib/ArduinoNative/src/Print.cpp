@@ -0,0 +1,99 @@
+/**
+ * @file Print.cpp
+ * @brief Formatting of the numbers (base, digits) and of the strings of the Print stand-in.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - number formatting of the Print stand-in
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "Print.h"
+
+/**
+ * @brief Text of a number in a base (2..36)
+ */
+static std::string numberText(unsigned long value, int base){
+  char digits[8 * sizeof(long) + 1];
+  char *digit = &digits[sizeof(digits) - 1];
+
+  if(base < 2 || base > 36)
+    base = 10;
+  *digit = 0;
+  do{
+    int remainder = value % base;
+    *--digit = remainder < 10 ? '0' + remainder : 'A' + remainder - 10;
+    value /= base;
+  }while(value);
+  return std::string(digit);
+}
+
+String::String(int value, unsigned char base) : String((long)value, base){}
+String::String(unsigned int value, unsigned char base) : String((unsigned long)value, base){}
+
+String::String(long value, unsigned char base){
+  if(value < 0 && base == 10)
+    text = "-" + numberText(-(unsigned long)value, base);
+  else
+    text = numberText(value, base);
+}
+
+String::String(unsigned long value, unsigned char base) : text(numberText(value, base)){}
+
+String::String(double value, unsigned char decimals){
+  char buffer[64];
+
+  snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+  text = buffer;
+}
+
+size_t Print::write(const uint8_t *buffer, size_t size){
+  size_t n = 0;
+
+  while(size--){
+    if(!write(*buffer++))
+      break;
+    n++;
+  }
+  return n;
+}
+
+size_t Print::write(const char *text){
+  if(!text)
+    return 0;
+  return write((const uint8_t *)text, strlen(text));
+}
+
+size_t Print::printNumber(unsigned long value, int base){
+  return write(numberText(value, base).c_str());
+}
+
+size_t Print::print(const char text[]){ return write(text); }
+size_t Print::print(char c){ return write((uint8_t)c); }
+size_t Print::print(const String &text){ return write(text.c_str()); }
+size_t Print::print(unsigned char value, int base){ return printNumber(value, base); }
+size_t Print::print(int value, int base){ return print((long)value, base); }
+size_t Print::print(unsigned int value, int base){ return printNumber(value, base); }
+
+size_t Print::print(long value, int base){
+  if(value < 0 && base == 10)
+    return print('-') + printNumber(-(unsigned long)value, base);
+  return printNumber(value, base);
+}
+
+size_t Print::print(unsigned long value, int base){ return printNumber(value, base); }
+size_t Print::print(double value, int decimals){ return print(String(value, decimals)); }
+
+size_t Print::println(void){ return write("\r\n"); }
+size_t Print::println(const char text[]){ return print(text) + println(); }
+size_t Print::println(char c){ return print(c) + println(); }
+size_t Print::println(const String &text){ return print(text) + println(); }
+size_t Print::println(unsigned char value, int base){ return print(value, base) + println(); }
+size_t Print::println(int value, int base){ return print(value, base) + println(); }
+size_t Print::println(unsigned int value, int base){ return print(value, base) + println(); }
+size_t Print::println(long value, int base){ return print(value, base) + println(); }
+size_t Print::println(unsigned long value, int base){ return print(value, base) + println(); }
+size_t Print::println(double value, int decimals){ return print(value, decimals) + println(); }
@@ -0,0 +1,52 @@
+/**
+ * @file Print.h
+ * @brief Stand-in of the Arduino Print class (env:native), formats the text and numbers for write()
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - Print stand-in of the native build
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef Print_h
+#define Print_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include "WString.h"
+
+class Print{
+  public:
+    virtual ~Print(){}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *text);
+    size_t write(const char *buffer, size_t size){ return write((const uint8_t *)buffer, size); }
+
+    size_t print(const char text[]);
+    size_t print(char c);
+    size_t print(const String &text);
+    size_t print(unsigned char value, int base = 10);
+    size_t print(int value, int base = 10);
+    size_t print(unsigned int value, int base = 10);
+    size_t print(long value, int base = 10);
+    size_t print(unsigned long value, int base = 10);
+    size_t print(double value, int decimals = 2);
+
+    size_t println(void);
+    size_t println(const char text[]);
+    size_t println(char c);
+    size_t println(const String &text);
+    size_t println(unsigned char value, int base = 10);
+    size_t println(int value, int base = 10);
+    size_t println(unsigned int value, int base = 10);
+    size_t println(long value, int base = 10);
+    size_t println(unsigned long value, int base = 10);
+    size_t println(double value, int decimals = 2);
+
+  private:
+    size_t printNumber(unsigned long value, int base);
+};
+
+#endif
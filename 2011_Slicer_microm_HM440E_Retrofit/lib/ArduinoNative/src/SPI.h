@@ -0,0 +1,23 @@
+/**
+ * @file SPI.h
+ * @brief Stand-in of the SPI library (env:native), the SdFat stand-in works on host files without a bus
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - SPI stand-in of the native build
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef SPI_h
+#define SPI_h
+
+#include "Arduino.h"
+
+class SPIClass{
+  public:
+    void begin(void){}
+    void end(void){}
+};
+
+#endif
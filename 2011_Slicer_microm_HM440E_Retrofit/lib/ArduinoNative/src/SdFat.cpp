@@ -0,0 +1,163 @@
+/**
+ * @file SdFat.cpp
+ * @brief Files of the SdFat stand-in opened in the directory of the host given by SDFAT_NATIVE_ROOT.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - host directory as the SD card
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "SdFat.h"
+
+int File::available(void){
+  long current;
+  long end;
+
+  if(!handle)
+    return 0;
+  current = ftell(handle);
+  fseek(handle, 0, SEEK_END);
+  end = ftell(handle);
+  fseek(handle, current, SEEK_SET);
+  return end - current;
+}
+
+int File::read(void){
+  if(!handle)
+    return -1;
+  return fgetc(handle);
+}
+
+int File::read(void *buffer, size_t count){
+  if(!handle)
+    return -1;
+  return fread(buffer, 1, count, handle);
+}
+
+int File::peek(void){
+  int c;
+
+  if(!handle)
+    return -1;
+  c = fgetc(handle);
+  if(c != EOF)
+    ungetc(c, handle);
+  return c;
+}
+
+size_t File::write(uint8_t data){
+  return write(&data, 1);
+}
+
+size_t File::write(const uint8_t *data, size_t count){
+  if(!handle)
+    return 0;
+  return fwrite(data, 1, count, handle);
+}
+
+bool File::seek(uint32_t position){
+  return handle && fseek(handle, position, SEEK_SET) == 0;
+}
+
+uint32_t File::position(void){
+  return handle ? ftell(handle) : 0;
+}
+
+uint32_t File::size(void){
+  uint32_t current;
+  uint32_t end;
+
+  if(!handle)
+    return 0;
+  current = ftell(handle);
+  fseek(handle, 0, SEEK_END);
+  end = ftell(handle);
+  fseek(handle, current, SEEK_SET);
+  return end;
+}
+
+void File::rewind(void){
+  seek(0);
+}
+
+void File::flush(void){
+  if(handle)
+    fflush(handle);
+}
+
+void File::close(void){
+  if(handle)
+    fclose(handle);
+  handle = NULL;
+}
+
+/**
+ * @brief Host path of a file of the card
+ *
+ * @return true if the path fits in the buffer
+ */
+bool SdFat::hostPath(const char *path, char *buffer, size_t size){
+  const char *root = getenv("SDFAT_NATIVE_ROOT");
+
+  if(!root)
+    root = SDFAT_NATIVE_ROOT;
+  while(*path == '/')
+    path++;
+  return snprintf(buffer, size, "%s/%s", root, path) < (int)size;
+}
+
+/**
+ * @brief The card is present if its directory exists
+ *
+ * @param csPin chip select, not used
+ * @return true if the directory exists
+ */
+bool SdFat::begin(uint8_t csPin){
+  char root[256];
+  struct stat info;
+
+  (void)csPin;
+  if(!hostPath("", root, sizeof(root)))
+    return false;
+  return stat(root, &info) == 0 && S_ISDIR(info.st_mode);
+}
+
+/**
+ * @brief Open a file, at its end for writing like SdFat
+ *
+ * @param path file of the card
+ * @param mode FILE_READ or FILE_WRITE
+ * @return File opened file, false if it cannot be opened
+ */
+File SdFat::open(const char *path, uint8_t mode){
+  char fullPath[256];
+  FILE *handle;
+
+  if(!hostPath(path, fullPath, sizeof(fullPath)))
+    return File();
+  if(mode == FILE_READ)
+    return File(fopen(fullPath, "rb"));
+  handle = fopen(fullPath, "r+b");
+  if(!handle)
+    handle = fopen(fullPath, "w+b");
+  if(handle)
+    fseek(handle, 0, SEEK_END);
+  return File(handle);
+}
+
+bool SdFat::exists(const char *path){
+  char fullPath[256];
+
+  return hostPath(path, fullPath, sizeof(fullPath)) && access(fullPath, F_OK) == 0;
+}
+
+bool SdFat::remove(const char *path){
+  char fullPath[256];
+
+  return hostPath(path, fullPath, sizeof(fullPath)) && unlink(fullPath) == 0;
+}
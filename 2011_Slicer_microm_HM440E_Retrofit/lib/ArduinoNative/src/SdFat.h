@@ -0,0 +1,58 @@
+/**
+ * @file SdFat.h
+ * @brief Stand-in of the SdFat library (env:native), the card is a directory of the host given by
+ *        the SDFAT_NATIVE_ROOT environment variable ("sdcard" in the working directory by default).
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - SdFat stand-in of the native build
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef SdFat_h
+#define SdFat_h
+
+#include <stdio.h>
+#include "Arduino.h"
+
+// Open modes, a file opened for writing is created if needed
+#define FILE_READ 0x01
+#define FILE_WRITE 0x02
+
+#define SDFAT_NATIVE_ROOT "sdcard"
+
+class File : public Print{
+  public:
+    File(FILE *handle = NULL) : handle(handle){}
+    operator bool(void) const { return handle != NULL; }
+    int available(void);
+    int read(void);
+    int read(void *buffer, size_t count);
+    int peek(void);
+    size_t write(uint8_t data);
+    size_t write(const uint8_t *data, size_t count);
+    using Print::write;
+    bool seek(uint32_t position);
+    uint32_t position(void);
+    uint32_t size(void);
+    void rewind(void);
+    void flush(void);
+    void close(void);
+
+  private:
+    FILE *handle;
+};
+
+class SdFat{
+  public:
+    bool begin(uint8_t csPin);
+    File open(const char *path, uint8_t mode = FILE_READ);
+    bool exists(const char *path);
+    bool remove(const char *path);
+
+  private:
+    bool hostPath(const char *path, char *buffer, size_t size);
+};
+
+#endif
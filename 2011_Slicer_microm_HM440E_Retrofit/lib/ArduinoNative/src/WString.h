@@ -0,0 +1,45 @@
+/**
+ * @file WString.h
+ * @brief Stand-in of the Arduino String class (env:native), the text is kept in a std::string
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - String stand-in of the native build
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef WString_h
+#define WString_h
+
+#include <string>
+
+class String{
+  public:
+    String(const char *text = "") : text(text ? text : ""){}
+    String(const std::string &text) : text(text){}
+    explicit String(char c) : text(1, c){}
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(double value, unsigned char decimals = 2);
+
+    const char *c_str(void) const { return text.c_str(); }
+    unsigned int length(void) const { return text.length(); }
+    char charAt(unsigned int index) const { return index < text.length() ? text[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    long toInt(void) const { return atol(text.c_str()); }
+    bool equals(const String &other) const { return text == other.text; }
+    bool operator==(const String &other) const { return text == other.text; }
+    bool operator!=(const String &other) const { return text != other.text; }
+    String &operator+=(const String &other){ text += other.text; return *this; }
+    String &operator+=(const char *other){ text += other; return *this; }
+    String &operator+=(char c){ text += c; return *this; }
+    String operator+(const String &other) const { return String(text + other.text); }
+
+  private:
+    std::string text;
+};
+
+#endif
@@ -0,0 +1,123 @@
+/**
+ * @file Wire.cpp
+ * @brief Transfers of the Wire stand-in given to the attached device models, with the bus time of
+ *        each transfer on the virtual clock.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - transfers given to the device models and bus time
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Wire.h"
+#include "NativeClock.h"
+
+TwoWire Wire;
+
+void TwoWire::beginTransmission(uint8_t address){
+  txAddress = address & 0x7F;
+  txCount = 0;
+  transmitting = true;
+}
+
+uint8_t TwoWire::endTransmission(bool stopBit){
+  uint8_t result = WIRE_ADDRESS_NACK;
+
+  (void)stopBit;
+  transmitting = false;
+  spendBusTime(txCount);
+  // a write to a group address reaches every device answering at it
+  for(int i=0;i<WIRE_MAX_DEVICES;i++){
+    if(!devices[i] || !devices[i]->acknowledge(txAddress))
+      continue;
+    if(!devices[i]->receive(txBuffer, txCount))
+      result = WIRE_DATA_NACK;
+    else if(result == WIRE_ADDRESS_NACK)
+      result = WIRE_SUCCESS;
+  }
+  return result;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, size_t quantity, bool stopBit){
+  (void)stopBit;
+  rxIndex = 0;
+  rxCount = 0;
+  if(quantity > WIRE_BUFFER_SIZE)
+    quantity = WIRE_BUFFER_SIZE;
+  spendBusTime(quantity);
+  // the first device answering drives the bus
+  for(int i=0;i<WIRE_MAX_DEVICES;i++){
+    if(devices[i] && devices[i]->acknowledge(address & 0x7F)){
+      rxCount = devices[i]->request(rxBuffer, quantity);
+      break;
+    }
+  }
+  return rxCount;
+}
+
+size_t TwoWire::write(uint8_t data){
+  if(!transmitting || txCount >= WIRE_BUFFER_SIZE)
+    return 0;
+  txBuffer[txCount++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity){
+  size_t i;
+
+  for(i=0;i<quantity;i++){
+    if(!write(data[i]))
+      break;
+  }
+  return i;
+}
+
+int TwoWire::available(void){
+  return rxCount - rxIndex;
+}
+
+int TwoWire::read(void){
+  if(rxIndex >= rxCount)
+    return -1;
+  return rxBuffer[rxIndex++];
+}
+
+int TwoWire::peek(void){
+  if(rxIndex >= rxCount)
+    return -1;
+  return rxBuffer[rxIndex];
+}
+
+/**
+ * @brief Time of a transfer on the bus: start, address and data bytes of 9 clocks (with the
+ *        acknowledge) and stop, the devices see the transfer at its end
+ *
+ * @param count data bytes
+ */
+void TwoWire::spendBusTime(size_t count){
+  nativeClock_spend_us(((1 + count) * 9 + 2) * 1000000ULL / clockFrequency);
+}
+
+/**
+ * @brief Attach a device model to the bus
+ *
+ * @param device model
+ * @return bool false if the bus has no free slot
+ */
+bool TwoWire::attach(WireDevice *device){
+  for(int i=0;i<WIRE_MAX_DEVICES;i++){
+    if(!devices[i]){
+      devices[i] = device;
+      return true;
+    }
+  }
+  return false;
+}
+
+void TwoWire::detach(WireDevice *device){
+  for(int i=0;i<WIRE_MAX_DEVICES;i++){
+    if(devices[i] == device)
+      devices[i] = NULL;
+  }
+}
@@ -0,0 +1,79 @@
+/**
+ * @file Wire.h
+ * @brief Stand-in of the Wire library (env:native). The transmissions are given to the device
+ *        models attached to the bus which acknowledge their address (all of them for a write to a
+ *        group address), an address without device is not acknowledged. Each transfer takes its
+ *        bus time at the clock frequency on the virtual clock of NativeClock.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - Wire stand-in with the device models of the bus
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef Wire_h
+#define Wire_h
+
+#include "Arduino.h"
+
+// Bus clock after begin() [Hz]
+#define WIRE_DEFAULT_CLOCK 100000
+// Bytes of a transmission or of a request
+#define WIRE_BUFFER_SIZE 64
+// Device models attached to the bus
+#define WIRE_MAX_DEVICES 16
+// endTransmission() results
+#define WIRE_SUCCESS 0
+#define WIRE_ADDRESS_NACK 2
+#define WIRE_DATA_NACK 3
+
+// Device model on the bus
+class WireDevice{
+  public:
+    virtual ~WireDevice(){}
+    // true if the device answers at the address (7 bits)
+    virtual bool acknowledge(uint8_t address) = 0;
+    // Bytes written by the master in one transmission, false if not acknowledged
+    virtual bool receive(const uint8_t *data, size_t count) = 0;
+    // Bytes read by the master, returns the number of bytes given
+    virtual size_t request(uint8_t *data, size_t count) = 0;
+};
+
+class TwoWire : public Print{
+  public:
+    void begin(void){}
+    void end(void){}
+    void setClock(uint32_t frequency){ if(frequency) clockFrequency = frequency; }
+
+    void beginTransmission(uint8_t address);
+    uint8_t endTransmission(bool stopBit = true);
+    uint8_t requestFrom(uint8_t address, size_t quantity, bool stopBit = true);
+    size_t write(uint8_t data);
+    size_t write(const uint8_t *data, size_t quantity);
+    using Print::write;
+    int available(void);
+    int read(void);
+    int peek(void);
+
+    // Host side: device models on the bus
+    bool attach(WireDevice *device);
+    void detach(WireDevice *device);
+
+  private:
+    void spendBusTime(size_t count);
+
+    uint32_t clockFrequency = WIRE_DEFAULT_CLOCK;
+    WireDevice *devices[WIRE_MAX_DEVICES] = {};
+    uint8_t txAddress = 0;
+    uint8_t txBuffer[WIRE_BUFFER_SIZE];
+    size_t txCount = 0;
+    bool transmitting = false;
+    uint8_t rxBuffer[WIRE_BUFFER_SIZE];
+    size_t rxCount = 0;
+    size_t rxIndex = 0;
+};
+
+extern TwoWire Wire;
+
+#endif
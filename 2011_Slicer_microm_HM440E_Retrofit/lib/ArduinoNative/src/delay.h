@@ -0,0 +1,17 @@
+/**
+ * @file delay.h
+ * @brief Stand-in of the delay functions header of the SAMD core (env:native), declared in Arduino.h
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - delay.h stand-in of the native build
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef delay_h
+#define delay_h
+
+#include "Arduino.h"
+
+#endif
@@ -10,7 +10,34 @@
 #define CONFIG_2004_01_V1_H
 #endif
 
+// Number of PCA9629A stepper channels fitted on the board (MOTOR_A, MOTOR_B, ...), only the
+// specimen feed by default, a machine with more channels fitted raises it in its build flags
+// (-DBOARD_MOTOR_CHANNELS=2), up to the entries of BOARD_MOTOR_CONFIG
+#ifndef BOARD_MOTOR_CHANNELS
+#define BOARD_MOTOR_CHANNELS   1
+#endif
+
+// MOTOR_A - Specimen feed
 #define IC1_PCA9629A_ADR    0x20
 
 #define IC1_PULSE_WIDTH_MS     5
-#define IC1_MOTOR_MODE_BIPOLAR 1
\ No newline at end of file
+#define IC1_MOTOR_MODE_BIPOLAR 1
+
+// MOTOR_B - Specimen orientation
+#define IC2_PCA9629A_ADR    0x21
+
+#define IC2_PULSE_WIDTH_MS     5
+#define IC2_MOTOR_MODE_BIPOLAR 1
+
+// MOTOR_C - Section conveyor (planned, add to BOARD_MOTOR_CHANNELS when fitted)
+#define IC3_PCA9629A_ADR    0x22
+
+#define IC3_PULSE_WIDTH_MS     5
+#define IC3_MOTOR_MODE_BIPOLAR 1
+
+// Channel settings in MOTOR_x order {address, pulse width, bipolar mode}
+#define BOARD_MOTOR_CONFIG { \
+    {IC1_PCA9629A_ADR, IC1_PULSE_WIDTH_MS, IC1_MOTOR_MODE_BIPOLAR}, \
+    {IC2_PCA9629A_ADR, IC2_PULSE_WIDTH_MS, IC2_MOTOR_MODE_BIPOLAR}, \
+    {IC3_PCA9629A_ADR, IC3_PULSE_WIDTH_MS, IC3_MOTOR_MODE_BIPOLAR}  \
+}
@@ -35,6 +35,7 @@
 /***************************************************************************************************/
 
 #include "LiquidCrystal_I2C.h"
+#include "i2cTrace.h"
 
 
 /**************************************************************************/
@@ -141,6 +142,7 @@ bool LiquidCrystal_I2C::begin(uint8_t lcd_colums, uint8_t lcd_rows, lcd_font_siz
 
   if (_PCF8574_initialisation == false) return false; //safety check, make sure the declaration of lcd pins is right
 
+  I2C_TRACE_TRANSFER(I2C_TRACE_RAW_WRITE, _PCF8574_address, 0, 0);
   Wire.beginTransmission(_PCF8574_address);
   if (Wire.endTransmission() != 0) return false;      //safety check, make sure the PCF8574 is connected
 
@@ -754,6 +756,7 @@ uint8_t LiquidCrystal_I2C::portMapping(uint8_t value)
 /**************************************************************************/
 bool LiquidCrystal_I2C::writePCF8574(uint8_t value)
 {
+  I2C_TRACE_TRANSFER(I2C_TRACE_RAW_WRITE, _PCF8574_address, 0, 1);
   Wire.beginTransmission(_PCF8574_address);
 
   #if defined(ARDUINO) && ((ARDUINO) >= 100)
@@ -784,6 +787,7 @@ bool LiquidCrystal_I2C::writePCF8574(uint8_t value)
 /**************************************************************************/
 uint8_t LiquidCrystal_I2C::readPCF8574()
 {
+  I2C_TRACE_TRANSFER(I2C_TRACE_RAW_READ, _PCF8574_address, 0, 1);
   #if defined(_VARIANT_ARDUINO_STM32_)
   Wire.requestFrom(_PCF8574_address, 1);
   #else
@@ -0,0 +1,187 @@
+/**
+ * @file adcFilter.h
+ * @brief Constant time filters for the ADC channels: moving average with running sum, median of N
+ *        and first order IIR with integer coefficient. AdcFilter holds the state of the filter
+ *        selected at runtime so that each channel gets its own filter chosen in config.
+ * @version 0.2
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - replaces the 5 sample AverageAdc of each channel
+ *         19.10.2026 - the filter states share a union, only the selected one is kept
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef adcFilter_h
+#define adcFilter_h
+
+#include <string.h>
+
+// Filter type (SLICERCONFIG.PotFilter, SLICERCONFIG.NtcFilter)
+#define ADC_FILTER_NONE 0
+#define ADC_FILTER_AVERAGE 1
+#define ADC_FILTER_MEDIAN 2
+#define ADC_FILTER_IIR 3
+
+// Filter sizes of the AdcFilter channels
+#define ADC_FILTER_AVERAGE_SIZE 8
+#define ADC_FILTER_MEDIAN_SIZE 5
+#define ADC_FILTER_IIR_SHIFT 3
+
+/**
+ * @brief Moving average over N values, the sum is updated with the new and the oldest value only
+ */
+template <unsigned char N>
+class MovingAverage{
+    public:
+        MovingAverage() : index(0), count(0), sum(0) {}
+        void reset(){ index = 0; count = 0; sum = 0; }
+        unsigned int apply(unsigned int value){
+            // the first value fills the window, no ramp from 0
+            if(!count){
+                for(unsigned char i=0;i<N;i++)
+                    window[i] = value;
+                sum = (unsigned long)value * N;
+                count = N;
+            }
+            sum += value;
+            sum -= window[index];
+            window[index] = value;
+            index = (index+1) % N;
+            return sum / N;
+        }
+    private:
+        unsigned int window[N];
+        unsigned char index;
+        unsigned char count;
+        unsigned long sum;
+};
+
+/**
+ * @brief Median of the last N values (N odd), the values are kept sorted, the oldest one is
+ *        replaced by the new one
+ */
+template <unsigned char N>
+class MedianFilter{
+    public:
+        MedianFilter() : index(0), count(0) {}
+        void reset(){ index = 0; count = 0; }
+        unsigned int apply(unsigned int value){
+            unsigned char i;
+            unsigned int oldest;
+
+            if(!count){
+                for(i=0;i<N;i++){
+                    window[i] = value;
+                    sorted[i] = value;
+                }
+                count = N;
+            }
+            oldest = window[index];
+            window[index] = value;
+            index = (index+1) % N;
+            // removes the oldest value from the sorted values
+            for(i=0;sorted[i]!=oldest;i++);
+            for(;i<N-1;i++)
+                sorted[i] = sorted[i+1];
+            // inserts the new value
+            for(i=N-1;i>0 && sorted[i-1]>value;i--)
+                sorted[i] = sorted[i-1];
+            sorted[i] = value;
+            return sorted[N/2];
+        }
+    private:
+        unsigned int window[N];
+        unsigned int sorted[N];
+        unsigned char index;
+        unsigned char count;
+};
+
+/**
+ * @brief First order low pass y += (x - y) / 2^SHIFT, the state keeps 8 fractional bits
+ */
+template <unsigned char SHIFT>
+class IirFilter{
+    public:
+        IirFilter() : started(false), state(0) {}
+        void reset(){ started = false; }
+        unsigned int apply(unsigned int value){
+            long input = (long)value << 8;
+            if(!started){
+                state = input;
+                started = true;
+            }
+            state += (input - state) >> SHIFT;
+            return (state + 0x80) >> 8;
+        }
+    private:
+        bool started;
+        long state;
+};
+
+/**
+ * @brief Filter of one ADC channel, the filter type is selected at runtime. The states of the
+ *        filters share the same memory, reset() starts the state of the selected one.
+ */
+class AdcFilter{
+    public:
+        AdcFilter() : type(ADC_FILTER_NONE) {}
+        void setType(unsigned char filterType){
+            type = filterType;
+            reset();
+        }
+        unsigned char getType(){ return type; }
+        void reset(){
+            switch(type){
+                case ADC_FILTER_AVERAGE: average.reset(); break;
+                case ADC_FILTER_MEDIAN: median.reset(); break;
+                case ADC_FILTER_IIR: iir.reset(); break;
+                default: break;
+            }
+        }
+        unsigned int apply(unsigned int value){
+            switch(type){
+                case ADC_FILTER_AVERAGE: return average.apply(value);
+                case ADC_FILTER_MEDIAN: return median.apply(value);
+                case ADC_FILTER_IIR: return iir.apply(value);
+                default: return value;
+            }
+        }
+    private:
+        unsigned char type;
+        union{
+            MovingAverage<ADC_FILTER_AVERAGE_SIZE> average;
+            MedianFilter<ADC_FILTER_MEDIAN_SIZE> median;
+            IirFilter<ADC_FILTER_IIR_SHIFT> iir;
+        };
+};
+
+/**
+ * @brief Filter type from its config name ("none", "average", "median", "iir")
+ *
+ * @param name filter name, NULL gives the default type
+ * @param defaultType type returned for a missing or unknown name
+ * @return unsigned char filter type
+ */
+inline unsigned char adcFilter_typeFromName(const char *name, unsigned char defaultType){
+    if(name == NULL) return defaultType;
+    if(!strcmp(name, "none")) return ADC_FILTER_NONE;
+    if(!strcmp(name, "average")) return ADC_FILTER_AVERAGE;
+    if(!strcmp(name, "median")) return ADC_FILTER_MEDIAN;
+    if(!strcmp(name, "iir")) return ADC_FILTER_IIR;
+    return defaultType;
+}
+
+/**
+ * @brief Config name of a filter type
+ */
+inline const char *adcFilter_typeName(unsigned char type){
+    switch(type){
+        case ADC_FILTER_AVERAGE: return "average";
+        case ADC_FILTER_MEDIAN: return "median";
+        case ADC_FILTER_IIR: return "iir";
+        default: return "none";
+    }
+}
+
+#endif
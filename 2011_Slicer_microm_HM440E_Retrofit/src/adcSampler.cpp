@@ -0,0 +1,545 @@
+/**
+ * @file adcSampler.cpp
+ * @brief Setup of the ADC, TC4, EVSYS and DMA descriptors on the SAMD21 and reading of the DMA frames:
+ *        the position samples are read in order with the write index of the DMA, the other inputs are
+ *        filtered on the last frame. The host build reads the inputs of the Arduino stand-in instead.
+ * @version 0.2
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - TC4, EVSYS and DMA setup of the fixed rate sampling
+ *         19.10.2026 - only the configured inputs are converted, two more DMA channels write the input,
+ *                      averaging and sampling time of the next slot
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <Arduino.h>
+#include "adcSampler.h"
+
+#ifdef ARDUINO_ARCH_SAMD
+#include "wiring_private.h"
+#endif
+
+// Settings of an analog input
+typedef struct t_adcChannel{
+    unsigned char pin;
+    unsigned char oversampling;         // 2^oversampling conversions averaged by the ADC
+    unsigned char sampleTime;           // SAMPCTRL, half ADC clock cycles
+} ADC_CHANNEL;
+
+static ADC_CHANNEL channels[ADC_SAMPLER_CHANNELS];
+static unsigned char channelCount=0;
+// Settings of each slot of the frame (index of channels), averaging reduced to fit in the slot period
+static ADC_CHANNEL slotSettings[ADC_SAMPLER_CHANNELS];
+// Index of the sampled input (blade position) in channels
+static unsigned char streamIndex;
+// Last result of each input, index of channels, given at the resolution of its slot
+static unsigned short scanValues[ADC_SAMPLER_CHANNELS];
+static bool scanning=false;
+
+// Circular buffer written by the DMA, a frame read by the consumer is set back to empty
+static volatile unsigned short sampleBuffer[ADC_SAMPLER_BUFFER_SIZE];
+// Frames in the buffer
+static unsigned int frameCount=ADC_SAMPLER_BUFFER_SIZE;
+static unsigned int readFrame=0;
+static unsigned long lastRead_ms=0;
+#ifndef ARDUINO_ARCH_SAMD
+static unsigned long lastSample_us=0;
+#endif
+
+#ifdef ARDUINO_ARCH_SAMD
+// Results in a frame, one slot per configured input in the order of channels
+static unsigned int frameSize=1;
+// INPUTCTRL and AVGCTRL|SAMPCTRL of the next slot, written by the DMA at the end of each conversion
+static uint32_t slotInputCtrl[ADC_SAMPLER_CHANNELS];
+static uint16_t slotAverageCtrl[ADC_SAMPLER_CHANNELS];
+// DMA channels started and stopped together, all triggered by the ADC result
+static const unsigned char dmaChannels[] = {ADC_SAMPLER_DMA_CHANNEL, ADC_SAMPLER_INPUT_DMA_CHANNEL, ADC_SAMPLER_SETTINGS_DMA_CHANNEL};
+
+// DMA descriptors must be 16 bytes aligned, the base table holds the first descriptor of each channel
+static DmacDescriptor dmaDescriptor[ADC_SAMPLER_SETTINGS_DMA_CHANNEL+1] __attribute__ ((aligned (16)));
+static DmacDescriptor dmaWriteback[ADC_SAMPLER_SETTINGS_DMA_CHANNEL+1] __attribute__ ((aligned (16)));
+// Descriptor linked to itself, the DMA loops on the whole buffer
+static DmacDescriptor dmaLoopDescriptor __attribute__ ((aligned (16)));
+
+static void syncADC(void){
+  while(ADC->STATUS.bit.SYNCBUSY);
+}
+
+static void syncTC4(void){
+  while(TC4->COUNT16.STATUS.bit.SYNCBUSY);
+}
+
+/**
+ * @brief ADC input (AINx) of a pin
+ *
+ * @param pin analog input (A0..A6)
+ * @return unsigned char ADC input number
+ */
+static unsigned char adcInput(unsigned char pin){
+  return g_APinDescription[pin].ulADCChannelNumber;
+}
+
+/**
+ * @brief Longest time of a result of the input (all its averaged conversions)
+ *
+ * @param channel input settings
+ * @return unsigned int conversion time [us]
+ */
+static unsigned int conversionTime_us(const ADC_CHANNEL *channel){
+  // ADC clock 48MHz/64: 4/3us per clock, sampling time + 6 clocks per 12bit conversion
+  return (1UL << channel->oversampling) * (6 + (channel->sampleTime + 2) / 2) * 4 / 3 + 1;
+}
+
+/**
+ * @brief Set up a descriptor transferring the ADC results to the buffer, from the index to the end of the frames
+ *
+ * @param descriptor pointer to the descriptor
+ * @param index first buffer slot written
+ */
+static void setDescriptor(DmacDescriptor *descriptor, unsigned int index){
+  descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_HWORD | DMAC_BTCTRL_DSTINC | DMAC_BTCTRL_BLOCKACT_NOACT;
+  descriptor->BTCNT.reg = frameCount * frameSize - index;
+  descriptor->SRCADDR.reg = (uint32_t)&ADC->RESULT.reg;
+  // with address increment the DMA expects the end address of the block
+  descriptor->DSTADDR.reg = (uint32_t)&sampleBuffer[frameCount * frameSize];
+  descriptor->DESCADDR.reg = (uint32_t)&dmaLoopDescriptor;
+}
+
+/**
+ * @brief Set up a descriptor linked to itself, writing a register with the next entry of a table
+ *        at each ADC result, the table holds one entry per frame slot
+ *
+ * @param descriptor pointer to the descriptor
+ * @param beatSize DMAC_BTCTRL_BEATSIZE_xxx of the register
+ * @param table first entry, settings of the slot 1
+ * @param tableBytes size of the frameSize entries
+ * @param reg register written
+ */
+static void setSequenceDescriptor(DmacDescriptor *descriptor, uint16_t beatSize, const void *table, unsigned int tableBytes, volatile void *reg){
+  descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | beatSize | DMAC_BTCTRL_SRCINC | DMAC_BTCTRL_BLOCKACT_NOACT;
+  descriptor->BTCNT.reg = frameSize;
+  // with address increment the DMA expects the end address of the block
+  descriptor->SRCADDR.reg = (uint32_t)table + tableBytes;
+  descriptor->DSTADDR.reg = (uint32_t)reg;
+  descriptor->DESCADDR.reg = (uint32_t)descriptor;
+}
+
+/**
+ * @brief Enable the DMA channels, the first result is written to the buffer slot given by index and
+ *        the settings of the slot 1 are written at the end of its conversion
+ *
+ * @param index first buffer slot written, first slot of a frame
+ */
+static void startDma(unsigned int index){
+  unsigned int i;
+
+  setDescriptor(&dmaDescriptor[ADC_SAMPLER_DMA_CHANNEL], index);
+  setDescriptor(&dmaLoopDescriptor, 0);
+  setSequenceDescriptor(&dmaDescriptor[ADC_SAMPLER_INPUT_DMA_CHANNEL], DMAC_BTCTRL_BEATSIZE_WORD,
+                        slotInputCtrl, frameSize * sizeof(slotInputCtrl[0]), &ADC->INPUTCTRL.reg);
+  // AVGCTRL and SAMPCTRL are adjacent bytes, written by a single half word
+  setSequenceDescriptor(&dmaDescriptor[ADC_SAMPLER_SETTINGS_DMA_CHANNEL], DMAC_BTCTRL_BEATSIZE_HWORD,
+                        slotAverageCtrl, frameSize * sizeof(slotAverageCtrl[0]), &ADC->AVGCTRL.reg);
+  for(i=0;i<sizeof(dmaChannels);i++){
+    DMAC->CHID.reg = DMAC_CHID_ID(dmaChannels[i]);
+    DMAC->CHCTRLA.reg = DMAC_CHCTRLA_ENABLE;
+  }
+}
+
+/**
+ * @brief Stop the DMA channels, the descriptor positions are lost
+ */
+static void stopDma(void){
+  unsigned int i;
+
+  for(i=0;i<sizeof(dmaChannels);i++){
+    DMAC->CHID.reg = DMAC_CHID_ID(dmaChannels[i]);
+    DMAC->CHCTRLA.reg = 0;
+    while(DMAC->CHCTRLA.bit.ENABLE);
+  }
+}
+
+/**
+ * @brief Stop the conversion trigger and wait for the last conversion to be transferred
+ */
+static void stopTrigger(void){
+  TC4->COUNT16.CTRLBSET.reg = TC_CTRLBSET_CMD_STOP;
+  syncTC4();
+  // waits for a conversion started just before the stop, each one ends within its slot
+  delayMicroseconds(1000000UL / (ADC_SAMPLER_RATE_HZ * frameSize) + 20);
+}
+
+/**
+ * @brief Restart the conversion trigger from the beginning of the period
+ */
+static void startTrigger(void){
+  TC4->COUNT16.CTRLBSET.reg = TC_CTRLBSET_CMD_RETRIGGER;
+  syncTC4();
+}
+
+/**
+ * @brief AVGCTRL and SAMPCTRL of an input, AVGCTRL in the low byte
+ *
+ * @param channel averaging and sampling time
+ * @return uint16_t register values
+ */
+static uint16_t averageCtrl(const ADC_CHANNEL *channel){
+  // over 16 conversions the sum is shifted by the ADC, ADJRES keeps oversampling/2 bits over 12 bits
+  unsigned char averaged = channel->oversampling < 4 ? channel->oversampling : 4;
+
+  return (ADC_AVGCTRL_SAMPLENUM(channel->oversampling) | ADC_AVGCTRL_ADJRES(averaged - channel->oversampling / 2)) |
+         (ADC_SAMPCTRL_SAMPLEN(channel->sampleTime) << 8);
+}
+
+/**
+ * @brief INPUTCTRL selecting a single ADC input, the gain set by the core is kept
+ *
+ * @param input ADC input (AINx)
+ * @return uint32_t register value
+ */
+static uint32_t inputCtrl(unsigned char input){
+  return (ADC->INPUTCTRL.reg & ~(ADC_INPUTCTRL_MUXPOS_Msk | ADC_INPUTCTRL_INPUTSCAN_Msk | ADC_INPUTCTRL_INPUTOFFSET_Msk)) |
+         ADC_INPUTCTRL_MUXPOS(input);
+}
+
+/**
+ * @brief Select the input with the averaging and sampling time, then enable the ADC
+ *
+ * @param channel averaging and sampling time
+ * @param input ADC input (AINx)
+ */
+static void configureADC(const ADC_CHANNEL *channel, unsigned char input){
+  uint16_t average = averageCtrl(channel);
+
+  syncADC();
+  ADC->CTRLA.bit.ENABLE = 0;
+  syncADC();
+  ADC->INPUTCTRL.reg = inputCtrl(input);
+  syncADC();
+  // the averaging needs the 16bit result, a single conversion stays on 12 bits in this mode
+  ADC->CTRLB.reg = ADC_CTRLB_PRESCALER_DIV64 | ADC_CTRLB_RESSEL_16BIT;
+  syncADC();
+  ADC->AVGCTRL.reg = average & 0xFF;
+  syncADC();
+  ADC->SAMPCTRL.reg = average >> 8;
+  syncADC();
+  ADC->INTFLAG.reg = ADC_INTFLAG_RESRDY;
+  ADC->CTRLA.bit.ENABLE = 1;
+  syncADC();
+}
+
+/**
+ * @brief Select the first slot of the frame, the DMA selects the next ones
+ */
+static void configureScan(void){
+  configureADC(&slotSettings[0], adcInput(channels[0].pin));
+}
+
+/**
+ * @brief Single conversion of an input, the DMA must be stopped
+ *
+ * @param channel averaging and sampling time
+ * @param pin analog input
+ * @return unsigned int ADC result
+ */
+static unsigned int convert(const ADC_CHANNEL *channel, unsigned char pin){
+  configureADC(channel, adcInput(pin));
+  // one start, the ADC runs all the averaged conversions
+  ADC->SWTRIG.bit.START = 1;
+  while(!ADC->INTFLAG.bit.RESRDY);
+  return ADC->RESULT.reg;
+}
+
+/**
+ * @brief Index of the next slot written by the DMA, first slot of the first incomplete frame after the read frame
+ *
+ * @return unsigned int buffer index
+ */
+static unsigned int writeIndex(void){
+  unsigned int i;
+  unsigned int frame = readFrame;
+
+  for(i=0;i<frameCount;i++){
+    if(sampleBuffer[frame * frameSize + frameSize - 1] == ADC_SAMPLER_EMPTY)
+      break;
+    frame = (frame+1) % frameCount;
+  }
+  return frame * frameSize;
+}
+#endif
+
+/**
+ * @brief Index of an analog input in the configured inputs
+ *
+ * @param pin analog input
+ * @return unsigned char index, channelCount if not configured
+ */
+static unsigned char channelIndex(unsigned char pin){
+  unsigned char i;
+
+  for(i=0;i<channelCount && channels[i].pin != pin;i++);
+  return i;
+}
+
+/**
+ * @brief Settings of an analog input, single conversion with the shortest sampling time if not set
+ *
+ * @param pin analog input
+ * @return ADC_CHANNEL input settings
+ */
+static ADC_CHANNEL channelSettings(unsigned char pin){
+  ADC_CHANNEL channel = {pin, 0, 0};
+  unsigned char i = channelIndex(pin);
+
+  if(i < channelCount)
+    return channels[i];
+  return channel;
+}
+
+/**
+ * @brief Left shift of the results of an input to 16 bits
+ *
+ * @param channel input settings
+ * @return unsigned char shift
+ */
+static unsigned char resultShift(const ADC_CHANNEL *channel){
+#ifdef ARDUINO_ARCH_SAMD
+  return ADC_SAMPLER_RESULT_BITS - 12 - channel->oversampling / 2;
+#else
+  // analogRead() gives 10 bits, no hardware averaging
+  (void)channel;
+  return ADC_SAMPLER_RESULT_BITS - 10;
+#endif
+}
+
+/**
+ * @brief Set the hardware averaging and the sampling time of an analog input and add it to the
+ *        frame. The averaging used in the frame slot is computed by adcSampler_init().
+ *
+ * @param pin analog input (A0..A6)
+ * @param oversampling 2^oversampling conversions averaged per result, oversampling/2 bits more resolution
+ * @param sampleTime sampling time in half ADC clock cycles, longer for the high impedance sources
+ */
+void adcSampler_setChannel(unsigned char pin, unsigned char oversampling, unsigned char sampleTime){
+  unsigned char i = channelIndex(pin);
+
+  if(oversampling > ADC_SAMPLER_MAX_OVERSAMPLING)
+    oversampling = ADC_SAMPLER_MAX_OVERSAMPLING;
+  if(sampleTime > ADC_SAMPLER_MAX_SAMPLE_TIME)
+    sampleTime = ADC_SAMPLER_MAX_SAMPLE_TIME;
+  if(i == ADC_SAMPLER_CHANNELS)
+    return;
+  if(i == channelCount)
+    channelCount++;
+  channels[i].pin = pin;
+  channels[i].oversampling = oversampling;
+  channels[i].sampleTime = sampleTime;
+}
+
+/**
+ * @brief Start the conversion of the configured inputs at ADC_SAMPLER_RATE_HZ, one frame slot per
+ *        input. Each slot keeps the sampling time of its input and the highest averaging up to the
+ *        input one that fits in the slot period.
+ *
+ * @param pin analog input of the blade position, read with adcSampler_read() (A0..A6)
+ */
+void adcSampler_init(unsigned char pin){
+  unsigned int i;
+
+  // the sampled input is scanned even without settings
+  if(channelIndex(pin) == channelCount)
+    adcSampler_setChannel(pin, 0, 0);
+  streamIndex = channelIndex(pin);
+  for(i=0;i<channelCount;i++){
+    slotSettings[i] = channels[i];
+    if(slotSettings[i].oversampling > ADC_SAMPLER_MAX_STREAM_OVERSAMPLING)
+      slotSettings[i].oversampling = ADC_SAMPLER_MAX_STREAM_OVERSAMPLING;
+  }
+  readFrame = 0;
+  lastRead_ms = millis();
+
+#ifndef ARDUINO_ARCH_SAMD
+  for(i=0;i<channelCount;i++)
+    scanValues[i] = analogRead(channels[i].pin);
+  lastSample_us = micros();
+#else
+  // only the configured inputs are converted, in the order of channels
+  frameSize = channelCount;
+  frameCount = ADC_SAMPLER_BUFFER_SIZE / frameSize;
+  for(i=0;i<channelCount;i++){
+    // each conversion must end before the start of the next slot
+    while(slotSettings[i].oversampling && conversionTime_us(&slotSettings[i]) >= 1000000UL / (ADC_SAMPLER_RATE_HZ * frameSize))
+      slotSettings[i].oversampling--;
+  }
+  for(i=0;i<ADC_SAMPLER_BUFFER_SIZE;i++)
+    sampleBuffer[i] = ADC_SAMPLER_EMPTY;
+
+  for(i=0;i<channelCount;i++)
+    pinPeripheral(channels[i].pin, PIO_ANALOG);
+  PM->APBCMASK.reg |= PM_APBCMASK_TC4 | PM_APBCMASK_EVSYS | PM_APBCMASK_ADC;
+  PM->AHBMASK.reg |= PM_AHBMASK_DMAC;
+  PM->APBBMASK.reg |= PM_APBBMASK_DMAC;
+
+  // TC4 clocked by GCLK0/8 (6MHz), one overflow event per input of a frame
+  GCLK->CLKCTRL.reg = GCLK_CLKCTRL_CLKEN | GCLK_CLKCTRL_GEN_GCLK0 | GCLK_CLKCTRL_ID_TC4_TC5;
+  while(GCLK->STATUS.bit.SYNCBUSY);
+  TC4->COUNT16.CTRLA.reg = TC_CTRLA_SWRST;
+  while(TC4->COUNT16.CTRLA.bit.SWRST);
+  TC4->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 | TC_CTRLA_WAVEGEN_MFRQ | TC_CTRLA_PRESCALER_DIV8;
+  TC4->COUNT16.CC[0].reg = (SystemCoreClock / 8 / (ADC_SAMPLER_RATE_HZ * frameSize)) - 1;
+  syncTC4();
+  TC4->COUNT16.EVCTRL.reg = TC_EVCTRL_OVFEO;
+
+  // TC4 overflow event starts the conversion of the next slot of the frame
+  EVSYS->USER.reg = EVSYS_USER_CHANNEL(ADC_SAMPLER_EVSYS_CHANNEL+1) | EVSYS_USER_USER(EVSYS_ID_USER_ADC_START);
+  EVSYS->CHANNEL.reg = EVSYS_CHANNEL_CHANNEL(ADC_SAMPLER_EVSYS_CHANNEL) | EVSYS_CHANNEL_EVGEN(EVSYS_ID_GEN_TC4_OVF) |
+                       EVSYS_CHANNEL_PATH_ASYNCHRONOUS | EVSYS_CHANNEL_EDGSEL_NO_EVT_OUTPUT;
+
+  // first result of each input before the scan, the software start is used while the event input is off
+  syncADC();
+  ADC->CTRLA.bit.ENABLE = 0;
+  syncADC();
+  ADC->EVCTRL.reg = 0;
+  for(i=0;i<channelCount;i++)
+    scanValues[i] = convert(&slotSettings[i], channels[i].pin);
+  syncADC();
+  ADC->CTRLA.bit.ENABLE = 0;
+  syncADC();
+  ADC->EVCTRL.reg = ADC_EVCTRL_STARTEI;
+  // the entry i selects the slot i+1, written at the end of the conversion of the slot i
+  for(i=0;i<frameSize;i++){
+    slotInputCtrl[i] = inputCtrl(adcInput(channels[(i+1) % frameSize].pin));
+    slotAverageCtrl[i] = averageCtrl(&slotSettings[(i+1) % frameSize]);
+  }
+
+  // DMA transfers each ADC result to its frame slot and selects the next slot
+  DMAC->CTRL.reg = 0;
+  DMAC->CTRL.reg = DMAC_CTRL_SWRST;
+  while(DMAC->CTRL.bit.SWRST);
+  DMAC->BASEADDR.reg = (uint32_t)dmaDescriptor;
+  DMAC->WRBADDR.reg = (uint32_t)dmaWriteback;
+  DMAC->CTRL.reg = DMAC_CTRL_DMAENABLE | DMAC_CTRL_LVLEN(0xf);
+  for(i=0;i<sizeof(dmaChannels);i++){
+    DMAC->CHID.reg = DMAC_CHID_ID(dmaChannels[i]);
+    DMAC->CHCTRLA.reg = DMAC_CHCTRLA_SWRST;
+    while(DMAC->CHCTRLA.bit.SWRST);
+    // the lowest channel has the priority, the result is read before the next slot is selected
+    DMAC->CHCTRLB.reg = DMAC_CHCTRLB_LVL(0) | DMAC_CHCTRLB_TRIGSRC(ADC_DMAC_ID_RESRDY) | DMAC_CHCTRLB_TRIGACT_BEAT;
+  }
+  startDma(0);
+
+  configureScan();
+  TC4->COUNT16.CTRLA.bit.ENABLE = 1;
+  syncTC4();
+#endif
+  scanning = true;
+}
+
+/**
+ * @brief Read the oldest blade position sample not read yet, the last results of the other inputs
+ *        are updated. If the buffer was not read during more than its length the samples were
+ *        overwritten, the buffer is flushed and the sampling restarts.
+ *
+ * @param sample pointer to the sample value read
+ * @return int 1 if a sample was read, 0 if no new sample
+ */
+int adcSampler_read(unsigned int *sample){
+  unsigned long now = millis();
+  unsigned int i;
+
+  if((now - lastRead_ms) >= (1000UL * frameCount / ADC_SAMPLER_RATE_HZ))
+    adcSampler_flush();
+  lastRead_ms = now;
+
+#ifdef ARDUINO_ARCH_SAMD
+  volatile unsigned short *frame = &sampleBuffer[readFrame * frameSize];
+
+  // the last slot is written last, the frame is complete
+  if(frame[frameSize-1] == ADC_SAMPLER_EMPTY)
+    return 0;
+  for(i=0;i<channelCount;i++)
+    scanValues[i] = frame[i];
+  for(i=0;i<frameSize;i++)
+    frame[i] = ADC_SAMPLER_EMPTY;
+  readFrame = (readFrame+1) % frameCount;
+#else
+  // without DMA the inputs are read once per elapsed sampling period
+  if((micros() - lastSample_us) < (1000000UL / ADC_SAMPLER_RATE_HZ))
+    return 0;
+  lastSample_us += 1000000UL / ADC_SAMPLER_RATE_HZ;
+  for(i=0;i<channelCount;i++)
+    scanValues[i] = analogRead(channels[i].pin);
+#endif
+  *sample = (unsigned int)scanValues[streamIndex] << resultShift(&slotSettings[streamIndex]);
+  return 1;
+}
+
+/**
+ * @brief Discard all the samples not read and restart the sampling
+ */
+void adcSampler_flush(void){
+  unsigned int i;
+
+#ifdef ARDUINO_ARCH_SAMD
+  stopTrigger();
+  stopDma();
+#endif
+  for(i=0;i<ADC_SAMPLER_BUFFER_SIZE;i++)
+    sampleBuffer[i] = ADC_SAMPLER_EMPTY;
+  readFrame = 0;
+  lastRead_ms = millis();
+#ifdef ARDUINO_ARCH_SAMD
+  // a stopped scan restarts from its first slot
+  configureScan();
+  startDma(0);
+  startTrigger();
+#else
+  lastSample_us = micros();
+#endif
+}
+
+/**
+ * @brief Last result of a configured input, updated by adcSampler_read() without any conversion.
+ *        An input not configured is converted by adcSampler_analogRead().
+ *
+ * @param pin analog input
+ * @return unsigned int ADC value, 16 bits
+ */
+unsigned int adcSampler_value(unsigned char pin){
+  unsigned char i = channelIndex(pin);
+
+  if(!scanning || i == channelCount)
+    return adcSampler_analogRead(pin);
+  return (unsigned int)scanValues[i] << resultShift(&slotSettings[i]);
+}
+
+/**
+ * @brief Conversion of an analog input with its settings, the scan is paused during the
+ *        conversion. The samples not read yet are kept. To be used instead of analogRead().
+ *
+ * @param pin analog input to convert
+ * @return unsigned int ADC value, 16 bits
+ */
+unsigned int adcSampler_analogRead(unsigned char pin){
+  ADC_CHANNEL channel = channelSettings(pin);
+  unsigned int value;
+
+#ifdef ARDUINO_ARCH_SAMD
+  if(scanning){
+    stopTrigger();
+    stopDma();
+  }
+  pinPeripheral(pin, PIO_ANALOG);
+  value = convert(&channel, pin);
+  if(scanning){
+    configureScan();
+    // the DMA continues at the frame interrupted by the stop
+    startDma(writeIndex());
+    startTrigger();
+  }
+#else
+  value = analogRead(pin);
+#endif
+  return value << resultShift(&channel);
+}
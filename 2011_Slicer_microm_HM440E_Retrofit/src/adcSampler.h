@@ -0,0 +1,54 @@
+/**
+ * @file adcSampler.h
+ * @brief Sampling of the analog inputs at a fixed rate. On the SAMD21 the ADC converts the
+ *        configured inputs only, one slot of the frame each, each conversion is started by the TC4
+ *        overflow event (EVSYS) and its result is written by the DMA to a circular buffer of frames,
+ *        independently of the main loop activity. At the end of each conversion two more DMA
+ *        channels write the input (INPUTCTRL), the averaging (AVGCTRL) and the sampling time
+ *        (SAMPCTRL) of the next slot, so each input keeps its own settings. The averaging of a slot
+ *        is reduced until its conversion fits in the slot period (1ms / inputs).
+ *        The consumer reads the blade position samples in order, the last result of the other inputs
+ *        is kept for adcSampler_value(). adcSampler_analogRead() converts with the full settings.
+ *        The results are given left aligned on 16 bits whatever the resolution of the input.
+ * @version 0.2
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - replaces the analogRead() of the loop, fixed rate sampling with TC4, EVSYS and DMA
+ *         19.10.2026 - configured inputs only with their own settings, DMA sequence of the slots
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef adcSampler_h
+#define adcSampler_h
+
+// Sampling rate of the blade position, rate of the scan frames [Hz]
+#define ADC_SAMPLER_RATE_HZ 1000
+// Circular buffer size in results (2048 = 512 frames of 4 inputs, 512ms at 1kHz)
+#define ADC_SAMPLER_BUFFER_SIZE 2048
+// Value of a buffer slot not written by the DMA yet (out of the range of the scanned inputs)
+#define ADC_SAMPLER_EMPTY 0xFFFF
+// Resolution of the results given by the sampler [bits]
+#define ADC_SAMPLER_RESULT_BITS 16
+// Hardware averaging: 2^oversampling conversions per result, oversampling/2 bits gained over 12 bits
+#define ADC_SAMPLER_MAX_OVERSAMPLING 8
+// The slot conversions must end within the slot period and stay under 16 bits (EMPTY)
+#define ADC_SAMPLER_MAX_STREAM_OVERSAMPLING 4
+// Sampling time of a conversion, in half ADC clock cycles (SAMPCTRL)
+#define ADC_SAMPLER_MAX_SAMPLE_TIME 63
+// Number of analog inputs with their own settings, one frame slot each
+#define ADC_SAMPLER_CHANNELS 8
+// DMA and event channels used by the sampler: results, next INPUTCTRL, next AVGCTRL|SAMPCTRL (highest)
+#define ADC_SAMPLER_DMA_CHANNEL 0
+#define ADC_SAMPLER_INPUT_DMA_CHANNEL 1
+#define ADC_SAMPLER_SETTINGS_DMA_CHANNEL 2
+#define ADC_SAMPLER_EVSYS_CHANNEL 0
+
+extern void adcSampler_setChannel(unsigned char pin, unsigned char oversampling, unsigned char sampleTime);
+extern void adcSampler_init(unsigned char pin);
+extern int adcSampler_read(unsigned int *sample);
+extern void adcSampler_flush(void);
+extern unsigned int adcSampler_value(unsigned char pin);
+extern unsigned int adcSampler_analogRead(unsigned char pin);
+
+#endif
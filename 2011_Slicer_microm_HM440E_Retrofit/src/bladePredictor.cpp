@@ -0,0 +1,144 @@
+/**
+ * @file bladePredictor.cpp
+ * @brief Velocity of the blade from the last position samples, predicted time of the next threshold
+ *        crossing and statistics of the predictions (hits, misses, late, mean error).
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - velocity estimation and check of the predictions
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <Arduino.h>
+#include "bladePredictor.h"
+#include "adcSampler.h"
+
+/**
+ * @brief Test if the position is beyond the threshold in the crossing direction
+ */
+static bool isCrossed(unsigned int position, unsigned int threshold, int direction){
+  if(direction == CROSS_FALLING)
+    return position <= threshold;
+  return position >= threshold;
+}
+
+/**
+ * @brief Clear the history and the statistics, set the prediction lead time
+ *
+ * @param predictor pointer to the predictor
+ * @param leadTime_ms time between the command and the predicted crossing, 0 disables the prediction
+ */
+void predictor_init(BLADEPREDICTOR *predictor, unsigned int leadTime_ms){
+  predictor->index = 0;
+  predictor->count = 0;
+  predictor->sampleCount = 0;
+  predictor->velocity = 0;
+  predictor->lead = (unsigned long)leadTime_ms * ADC_SAMPLER_RATE_HZ / 1000;
+  predictor->pending = false;
+  predictor_resetStats(predictor);
+}
+
+/**
+ * @brief Clear the hit/miss statistics
+ *
+ * @param predictor pointer to the predictor
+ */
+void predictor_resetStats(BLADEPREDICTOR *predictor){
+  predictor->predicted = 0;
+  predictor->hits = 0;
+  predictor->misses = 0;
+  predictor->late = 0;
+  predictor->errorSum = 0;
+}
+
+/**
+ * @brief Add a position sample, update the velocity and check the pending prediction
+ *
+ * @param predictor pointer to the predictor
+ * @param position blade position sampled at ADC_SAMPLER_RATE_HZ
+ */
+void predictor_update(BLADEPREDICTOR *predictor, unsigned int position){
+  unsigned int oldest;
+
+  // the slot written is the oldest position of a full history
+  oldest = predictor->history[predictor->index];
+  predictor->history[predictor->index] = position;
+  predictor->index = (predictor->index+1) & (PREDICTOR_HISTORY_SIZE-1);
+  predictor->sampleCount++;
+  if(predictor->count < PREDICTOR_HISTORY_SIZE){
+    predictor->count++;
+    predictor->velocity = 0;
+  }else predictor->velocity = ((long)position - (long)oldest) * ADC_SAMPLER_RATE_HZ / PREDICTOR_HISTORY_SIZE;
+
+  if(predictor->pending){
+    if(isCrossed(position, predictor->pendingThreshold, predictor->pendingDirection)){
+      predictor->hits++;
+      predictor->errorSum += (long)(predictor->sampleCount - predictor->pendingCross);
+      predictor->pending = false;
+    }
+    // not crossed one lead time after the predicted crossing, the blade turned back
+    else if((long)(predictor->sampleCount - predictor->pendingCross) > (long)predictor->lead){
+      predictor->misses++;
+      predictor->pending = false;
+    }
+  }
+}
+
+/**
+ * @brief Detect the crossing of a threshold, reached or predicted to occur within the lead time
+ *
+ * @param predictor pointer to the predictor
+ * @param threshold position threshold
+ * @param direction CROSS_FALLING or CROSS_RISING
+ * @return int CROSS_REACHED, CROSS_PREDICTED or CROSS_NONE
+ */
+int predictor_crossing(BLADEPREDICTOR *predictor, unsigned int threshold, int direction){
+  unsigned int position;
+  long distance;
+  long speed;
+  long timeToCross;
+
+  if(!predictor->count)
+    return CROSS_NONE;
+  position = predictor->history[(predictor->index-1) & (PREDICTOR_HISTORY_SIZE-1)];
+
+  if(isCrossed(position, threshold, direction)){
+    predictor->late++;
+    return CROSS_REACHED;
+  }
+
+  speed = (long)predictor->velocity * direction;
+  if(!predictor->lead || speed < PREDICTOR_MIN_VELOCITY)
+    return CROSS_NONE;
+
+  // time to cross at constant velocity [samples]
+  distance = (long)threshold - (long)position;
+  if(distance < 0)
+    distance = -distance;
+  timeToCross = distance * ADC_SAMPLER_RATE_HZ / speed;
+  if(timeToCross > (long)predictor->lead)
+    return CROSS_NONE;
+
+  predictor->predicted++;
+  // a previous prediction not verified yet is counted as missed
+  if(predictor->pending)
+    predictor->misses++;
+  predictor->pending = true;
+  predictor->pendingDirection = direction;
+  predictor->pendingThreshold = threshold;
+  predictor->pendingCross = predictor->sampleCount + timeToCross;
+  return CROSS_PREDICTED;
+}
+
+/**
+ * @brief Mean time between the predicted and the real crossings of the hits, positive if late
+ *
+ * @param predictor pointer to the predictor
+ * @return int mean error [ms]
+ */
+int predictor_meanError_ms(BLADEPREDICTOR *predictor){
+  if(!predictor->hits)
+    return 0;
+  return predictor->errorSum * 1000 / ((long)predictor->hits * ADC_SAMPLER_RATE_HZ);
+}
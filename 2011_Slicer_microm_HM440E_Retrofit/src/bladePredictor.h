@@ -0,0 +1,60 @@
+/**
+ * @file bladePredictor.h
+ * @brief Blade velocity estimation on the fixed rate position samples and prediction of the
+ *        threshold crossings, so that the motor command can be sent before the crossing to hide
+ *        the I2C command latency. Each prediction is checked against the real crossing.
+ * @version 0.2
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - blade predictor, the motor command is sent ahead of the threshold crossing
+ *         19.10.2026 - statistics sent with the serial profile dump
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef bladePredictor_h
+#define bladePredictor_h
+
+// Number of samples between the two positions used for the velocity, power of 2
+#define PREDICTOR_HISTORY_SIZE 32
+// Velocity under which no crossing is predicted (ADC noise) [16 bit ADC counts/s]
+#define PREDICTOR_MIN_VELOCITY 12800
+
+// Crossing direction
+#define CROSS_FALLING -1
+#define CROSS_RISING 1
+
+// Crossing detection result
+#define CROSS_NONE 0
+#define CROSS_REACHED 1
+#define CROSS_PREDICTED 2
+
+typedef struct t_bladePredictor{
+    unsigned int history[PREDICTOR_HISTORY_SIZE];   // Last positions
+    unsigned char index;                            // Next history slot
+    unsigned char count;                            // Number of valid positions
+    unsigned long sampleCount;                      // Time base, one unit per sample
+    unsigned int lead;                              // Prediction lead [samples], 0 disables the prediction
+    int velocity;                                   // Blade velocity [ADC counts/s]
+
+    // Prediction waiting for the real crossing
+    bool pending;
+    int pendingDirection;
+    unsigned int pendingThreshold;
+    unsigned long pendingCross;                     // Predicted crossing [samples]
+
+    // Statistics
+    unsigned int predicted;                         // Crossings predicted
+    unsigned int hits;                              // Predicted crossings which really occurred
+    unsigned int misses;                            // Predicted crossings which did not occur
+    unsigned int late;                              // Crossings reached without prediction
+    long errorSum;                                  // Sum of the real minus predicted crossing times of the hits [samples]
+} BLADEPREDICTOR;
+
+extern void predictor_init(BLADEPREDICTOR *predictor, unsigned int leadTime_ms);
+extern void predictor_update(BLADEPREDICTOR *predictor, unsigned int position);
+extern int predictor_crossing(BLADEPREDICTOR *predictor, unsigned int threshold, int direction);
+extern void predictor_resetStats(BLADEPREDICTOR *predictor);
+extern int predictor_meanError_ms(BLADEPREDICTOR *predictor);
+
+#endif
@@ -0,0 +1,168 @@
+/**
+ * @file buzzerSequencer.cpp
+ * @brief TC5 setup and interrupt: the compare value is loaded with the duration of the next step of
+ *        the pattern, the buzzer pin is switched in the interrupt and the timer stopped at the end.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - TC5 setup and interrupt of the buzzer patterns
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <Arduino.h>
+#include "buzzerSequencer.h"
+
+// Step durations [ms], buzzer on for the even steps and off for the odd ones, 0 ends the pattern
+static const unsigned short confirmSteps[] = {60, 0};
+static const unsigned short limitSteps[] = {40, 60, 40, 0};
+static const unsigned short alarmSteps[] = {500, 500, 500, 500, 500, 0};
+static const unsigned short faultSteps[] = {1000, 200, 150, 200, 150, 200, 1000, 0};
+
+static const unsigned short *const patterns[BUZZER_PATTERNS] = {confirmSteps, limitSteps, alarmSteps, faultSteps};
+
+static unsigned char buzzerPin;
+// Pattern played and its current step, written by play/stop with the interrupt disabled
+static const unsigned short *volatile playedSteps=NULL;
+static volatile unsigned char playedPattern;
+static volatile unsigned char stepIndex;
+
+#ifdef ARDUINO_ARCH_SAMD
+static void syncTC5(void){
+  while(TC5->COUNT16.STATUS.bit.SYNCBUSY);
+}
+
+/**
+ * @brief Start the step timer, its interrupt occurs at the end of the step
+ *
+ * @param duration_ms step duration
+ */
+static void startTimer(unsigned short duration_ms){
+  if(duration_ms > BUZZER_MAX_STEP_MS)
+    duration_ms = BUZZER_MAX_STEP_MS;
+  TC5->COUNT16.CTRLA.bit.ENABLE = 0;
+  syncTC5();
+  TC5->COUNT16.COUNT.reg = 0;
+  syncTC5();
+  TC5->COUNT16.CC[0].reg = (unsigned long)duration_ms * (SystemCoreClock / 1024) / 1000 - 1;
+  syncTC5();
+  TC5->COUNT16.INTFLAG.reg = TC_INTFLAG_OVF;
+  TC5->COUNT16.CTRLA.bit.ENABLE = 1;
+  syncTC5();
+}
+
+/**
+ * @brief Stop the step timer
+ */
+static void stopTimer(void){
+  TC5->COUNT16.CTRLA.bit.ENABLE = 0;
+  syncTC5();
+  TC5->COUNT16.INTFLAG.reg = TC_INTFLAG_OVF;
+}
+#endif
+
+/**
+ * @brief Set up the buzzer output and the step timer
+ *
+ * @param pin buzzer output
+ */
+void buzzer_init(unsigned char pin){
+  buzzerPin = pin;
+  pinMode(pin, OUTPUT);
+  digitalWrite(pin, LOW);
+  playedSteps = NULL;
+
+#ifdef ARDUINO_ARCH_SAMD
+  // TC5 clocked by GCLK0 (48MHz), overflow interrupt at the end of each step
+  PM->APBCMASK.reg |= PM_APBCMASK_TC5;
+  GCLK->CLKCTRL.reg = GCLK_CLKCTRL_CLKEN | GCLK_CLKCTRL_GEN_GCLK0 | GCLK_CLKCTRL_ID_TC4_TC5;
+  while(GCLK->STATUS.bit.SYNCBUSY);
+  TC5->COUNT16.CTRLA.reg = TC_CTRLA_SWRST;
+  while(TC5->COUNT16.CTRLA.bit.SWRST);
+  TC5->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 | TC_CTRLA_WAVEGEN_MFRQ | TC_CTRLA_PRESCALER_DIV1024;
+  syncTC5();
+  TC5->COUNT16.INTENSET.reg = TC_INTENSET_OVF;
+  // lowest priority, the step timing tolerates the latency of the other interrupts
+  NVIC_SetPriority(TC5_IRQn, 3);
+  NVIC_EnableIRQ(TC5_IRQn);
+#endif
+}
+
+/**
+ * @brief Play a pattern from its beginning
+ *
+ * @param pattern BUZZER_xxx
+ * @return int 0 if played, -1 if unknown or a pattern with a higher priority is played
+ */
+int buzzer_play(unsigned char pattern){
+  if(pattern >= BUZZER_PATTERNS)
+    return -1;
+  if(playedSteps && playedPattern > pattern)
+    return -1;
+
+#ifdef ARDUINO_ARCH_SAMD
+  NVIC_DisableIRQ(TC5_IRQn);
+  playedPattern = pattern;
+  playedSteps = patterns[pattern];
+  stepIndex = 0;
+  digitalWrite(buzzerPin, HIGH);
+  startTimer(playedSteps[0]);
+  NVIC_EnableIRQ(TC5_IRQn);
+#else
+  // without the step timer the patterns are not played
+#endif
+  return 0;
+}
+
+/**
+ * @brief Stop the pattern played, the buzzer is switched off
+ */
+void buzzer_stop(void){
+#ifdef ARDUINO_ARCH_SAMD
+  NVIC_DisableIRQ(TC5_IRQn);
+  stopTimer();
+#endif
+  playedSteps = NULL;
+  digitalWrite(buzzerPin, LOW);
+#ifdef ARDUINO_ARCH_SAMD
+  NVIC_EnableIRQ(TC5_IRQn);
+#endif
+}
+
+/**
+ * @brief Pattern in progress
+ *
+ * @return true if a pattern is played
+ */
+bool buzzer_isPlaying(void){
+  return playedSteps != NULL;
+}
+
+/**
+ * @brief End of a step, switches the buzzer for the next step or ends the pattern (interrupt context)
+ */
+void buzzer_step(void){
+  if(!playedSteps)
+    return;
+  stepIndex++;
+  if(playedSteps[stepIndex] == 0){
+    playedSteps = NULL;
+    digitalWrite(buzzerPin, LOW);
+#ifdef ARDUINO_ARCH_SAMD
+    stopTimer();
+#endif
+    return;
+  }
+  // on for the even steps
+  digitalWrite(buzzerPin, (stepIndex & 1) ? LOW : HIGH);
+#ifdef ARDUINO_ARCH_SAMD
+  startTimer(playedSteps[stepIndex]);
+#endif
+}
+
+#ifdef ARDUINO_ARCH_SAMD
+void TC5_Handler(void){
+  TC5->COUNT16.INTFLAG.reg = TC_INTFLAG_OVF;
+  buzzer_step();
+}
+#endif
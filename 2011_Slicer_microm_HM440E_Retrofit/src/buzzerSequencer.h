@@ -0,0 +1,34 @@
+/**
+ * @file buzzerSequencer.h
+ * @brief Buzzer patterns played by the TC5 interrupt. A pattern is a list of on and off durations,
+ *        the interrupt switches the buzzer at the end of each step so the timing does not depend
+ *        on the main loop. A pattern replaces the one played unless the latter has a higher priority.
+ *        tone() uses TC5 as well and must not be used with the sequencer.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - replaces the blocking tone() and delay() beeps of the loop
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef buzzerSequencer_h
+#define buzzerSequencer_h
+
+// Patterns, from the lowest to the highest priority
+#define BUZZER_CONFIRM 0            // value saved
+#define BUZZER_LIMIT 1              // limit of a value or of the blade travel reached
+#define BUZZER_ALARM 2              // temperature threshold reached
+#define BUZZER_FAULT 3              // hardware or configuration error
+#define BUZZER_PATTERNS 4
+
+// Longest step of a pattern [ms], TC5 16 bit counter at 48MHz/1024
+#define BUZZER_MAX_STEP_MS 1300
+
+extern void buzzer_init(unsigned char pin);
+extern int buzzer_play(unsigned char pattern);
+extern void buzzer_stop(void);
+extern bool buzzer_isPlaying(void);
+extern void buzzer_step(void);
+
+#endif
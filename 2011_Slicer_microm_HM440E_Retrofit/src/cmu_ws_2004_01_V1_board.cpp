@@ -6,22 +6,63 @@
 
 board_2004_01_V01::board_2004_01_V01(void){
     //Wire.begin();                       // Initiate the Wire library for I2C
+    const unsigned char motorConfig[][3] = BOARD_MOTOR_CONFIG;
+    unsigned char i;
 
-    CHANNEL_A_MOTOR.deviceAddress = IC1_PCA9629A_ADR;
-    CHANNEL_A_MOTOR.pulsesWidth_ms = IC1_PULSE_WIDTH_MS;
-    CHANNEL_A_MOTOR.bipolar_mode = IC1_MOTOR_MODE_BIPOLAR;
+    static_assert(BOARD_MOTOR_CHANNELS >= 1 && BOARD_MOTOR_CHANNELS <= sizeof(motorConfig) / sizeof(motorConfig[0]),
+                  "BOARD_MOTOR_CHANNELS must be 1 up to the entries of BOARD_MOTOR_CONFIG");
+
+    for(i=0; i<BOARD_MOTOR_CHANNELS; i++){
+        MOTOR_CHANNEL[i].deviceAddress = motorConfig[i][0];
+        MOTOR_CHANNEL[i].pulsesWidth_ms = motorConfig[i][1];
+        MOTOR_CHANNEL[i].bipolar_mode = motorConfig[i][2];
+
+        MOTOR_QUEUE[i].head = 0;
+        MOTOR_QUEUE[i].count = 0;
+        MOTOR_QUEUE[i].stagedDirection = MOTOR_STOP;
+        MOTOR_QUEUE[i].runningDirection = MOTOR_STOP;
+        MOTOR_QUEUE[i].continuousAction = false;
+        MOTOR_QUEUE[i].moveStart_ms = 0;
+        MOTOR_QUEUE[i].moveDuration_ms = 0;
+        MOTOR_QUEUE[i].timeoutCount = 0;
+        MOTOR_QUEUE[i].group = MOTOR_GROUP_NONE;
+    }
 }
 
 void board_2004_01_V01::begin(void){
-    pca9629_init(&CHANNEL_A_MOTOR);
+    unsigned char i;
+
+    for(i=0; i<BOARD_MOTOR_CHANNELS; i++){
+        pca9629_init(&MOTOR_CHANNEL[i]);
+
+        // Every channel answers to the all call address for the common emergency stop
+        PCA9629_ModeConfig(&MOTOR_CHANNEL[i], PCA9629_MODE_DEFAULT | PCA9629_MODE_ALLCALL);
 	
-	// Config P2 & P3 for L298P Enable 
-	PCA9629_GPIOConfig(&CHANNEL_A_MOTOR, 0xC3);
+        // Config P2 & P3 for L298P Enable 
+        PCA9629_GPIOConfig(&MOTOR_CHANNEL[i], 0xC3);
+    }
+}
+
+/**
+ * @brief Get the channel index of a motor number
+ * 
+ * @return int channel index, -1 if the motor is not fitted (BOARD_MOTOR_CHANNELS)
+ */
+int board_2004_01_V01::channelIndex(unsigned char motor){
+    if(motor < BOARD_MOTOR_CHANNELS)
+        return motor;
+    return -1;
 }
 
 void  board_2004_01_V01::stepperRotation(char motor, int speed, int steps){
-    int direction;
+    int direction = MOTOR_STOP;
+    int signedSpeed = speed;
     device_pca9629 *selectedMotor;
+    MOTION_QUEUE *queue;
+    int channel = channelIndex(motor);
+
+    if(channel < 0)
+        return;
     if(speed > 0)
         direction = 1;
     else 
@@ -31,40 +72,377 @@ void  board_2004_01_V01::stepperRotation(char motor, int speed, int steps){
             speed*=-1;
         }
    
-    switch (motor){
-        case MOTOR_A: selectedMotor = &CHANNEL_A_MOTOR; break;
-        default: selectedMotor = &CHANNEL_A_MOTOR; break;
+    selectedMotor = &MOTOR_CHANNEL[channel];
+    queue = &MOTOR_QUEUE[channel];
+
+    // Same move as the one waiting in the queue, start it from the preloaded registers
+    if(queue->count && queue->command[queue->head].speed == signedSpeed && queue->command[queue->head].steps == steps){
+        startHeadRotation(selectedMotor, queue);
+        return;
     }
 
+    // Any other move rewrites the registers of both directions and cancels the queued commands
+    flushStepperQueue(motor);
+
     actuator_setStepperSpeed(selectedMotor, speed);
     actuator_setStepperStepAction(selectedMotor, direction, steps);
+
+    queue->runningDirection = direction;
+    queue->continuousAction = (steps <= 0);
+    predictMoveEnd(queue, speed, steps);
 }
 
+/**
+ * @brief Add a single action to the motion queue of the motor. The command is preloaded in the
+ * PCA9629A as soon as its direction registers are not used by the running move, so starting it
+ * later only needs the MCNTL write.
+ * 
+ * @param motor motor number
+ * @param speed speed in %, the sign gives the direction
+ * @param steps number of steps (>0)
+ * @return int 0 if queued, -1 if the motor is not fitted, the queue is full or the command is not
+ * a single action
+ */
+int  board_2004_01_V01::queueStepperRotation(char motor, int speed, int steps){
+    device_pca9629 *selectedMotor;
+    MOTION_QUEUE *queue;
+    int channel = channelIndex(motor);
 
-int  board_2004_01_V01::getStepperState(unsigned char motorNumber){
+    if(channel < 0)
+        return -1;
+    selectedMotor = &MOTOR_CHANNEL[channel];
+    queue = &MOTOR_QUEUE[channel];
+
+    if(speed == 0 || steps <= 0 || queue->count >= MOTION_QUEUE_SIZE)
+        return -1;
+
+    queue->command[(queue->head + queue->count) % MOTION_QUEUE_SIZE].speed = speed;
+    queue->command[(queue->head + queue->count) % MOTION_QUEUE_SIZE].steps = steps;
+    queue->count++;
+
+    stageQueuedRotation(selectedMotor, queue);
+    return 0;
+}
+
+/**
+ * @brief Start the command at the head of the motion queue, the motor must be stopped
+ * 
+ * @param motor motor number
+ * @return int 0 if started, -1 if the motor is not fitted or the queue is empty
+ */
+int  board_2004_01_V01::startQueuedRotation(char motor){
     device_pca9629 *selectedMotor;
+    MOTION_QUEUE *queue;
+    int channel = channelIndex(motor);
+
+    if(channel < 0)
+        return -1;
+    selectedMotor = &MOTOR_CHANNEL[channel];
+    queue = &MOTOR_QUEUE[channel];
+
+    if(!queue->count)
+        return -1;
+
+    startHeadRotation(selectedMotor, queue);
+    return 0;
+}
+
+/**
+ * @brief Get the number of commands waiting in the motion queue of the motor
+ * 
+ * @param motor motor number
+ * @return int number of commands, -1 if the motor is not fitted
+ */
+int  board_2004_01_V01::getQueuedRotationCount(char motor){
+    int channel = channelIndex(motor);
+
+    if(channel < 0)
+        return -1;
+    return MOTOR_QUEUE[channel].count;
+}
+
+void  board_2004_01_V01::flushStepperQueue(char motor){
+    MOTION_QUEUE *queue;
+    int channel = channelIndex(motor);
+
+    if(channel < 0)
+        return;
+    queue = &MOTOR_QUEUE[channel];
+    queue->count = 0;
+    queue->stagedDirection = MOTOR_STOP;
+}
+
+/**
+ * @brief Preload the head command in the registers of its direction if they are free
+ * (the running move uses the other direction or the motor is stopped)
+ */
+void  board_2004_01_V01::stageQueuedRotation(device_pca9629 *selectedMotor, MOTION_QUEUE *queue){
+    MOTION_COMMAND *command = &queue->command[queue->head];
+    int direction;
+
+    if(!queue->count || queue->stagedDirection != MOTOR_STOP)
+        return;
+
+    direction = (command->speed < 0) ? MOTOR_CCW : MOTOR_CW;
+    if(direction == queue->runningDirection)
+        return;
+
+    actuator_stageStepperStepAction(selectedMotor, direction, abs(command->speed), command->steps);
+    queue->stagedDirection = direction;
+}
+
+/**
+ * @brief Start the head command and preload the next one
+ */
+void  board_2004_01_V01::startHeadRotation(device_pca9629 *selectedMotor, MOTION_QUEUE *queue){
+    MOTION_COMMAND *command = &queue->command[queue->head];
+    int direction = (command->speed < 0) ? MOTOR_CCW : MOTOR_CW;
+
+    // Back to single action mode after a continuous rotation or a stop
+    if(queue->continuousAction){
+        PCA9629_StepperMotorControl(selectedMotor, 0x00);
+        PCA9629_StepperMotorMode(selectedMotor, 0x01);
+        queue->continuousAction = false;
+    }
+
+    // Registers not preloaded (the direction was in use when the command was queued)
+    if(queue->stagedDirection != direction)
+        actuator_stageStepperStepAction(selectedMotor, direction, abs(command->speed), command->steps);
+
+    actuator_startStepperStepAction(selectedMotor, direction);
+    startedHeadRotation(selectedMotor, queue);
+}
+
+/**
+ * @brief Remove the head command once started and preload the next one
+ */
+void  board_2004_01_V01::startedHeadRotation(device_pca9629 *selectedMotor, MOTION_QUEUE *queue){
+    MOTION_COMMAND *command = &queue->command[queue->head];
+
+    predictMoveEnd(queue, abs(command->speed), command->steps);
+
+    queue->runningDirection = (command->speed < 0) ? MOTOR_CCW : MOTOR_CW;
+    queue->stagedDirection = MOTOR_STOP;
+    queue->head = (queue->head + 1) % MOTION_QUEUE_SIZE;
+    queue->count--;
+
+    stageQueuedRotation(selectedMotor, queue);
+}
 
-    switch (motorNumber){
-    case 0: selectedMotor = &CHANNEL_A_MOTOR; break;
-    default: selectedMotor = &CHANNEL_A_MOTOR; break;
+/**
+ * @brief Add the motor to a synchronised start group, the channel answers to the
+ * PCA9629A sub-address of the group (MOTOR_GROUP_NONE to remove it from its group)
+ * 
+ * @param motor motor number
+ * @param group MOTOR_GROUP_NONE, MOTOR_GROUP_1..3
+ * @return int code error, -1 if the motor is not fitted or the group is unknown
+ */
+int  board_2004_01_V01::setStepperGroup(char motor, unsigned char group){
+    const unsigned char groupModeBit[] = {0, PCA9629_MODE_SUB1, PCA9629_MODE_SUB2, PCA9629_MODE_SUB3};
+    int channel = channelIndex(motor);
+
+    if(channel < 0 || group > MOTOR_GROUP_3)
+        return -1;
+
+    MOTOR_QUEUE[channel].group = group;
+    return PCA9629_ModeConfig(&MOTOR_CHANNEL[channel], PCA9629_MODE_DEFAULT | PCA9629_MODE_ALLCALL | groupModeBit[group]);
+}
+
+/**
+ * @brief Start the queued command of every motor of the group with one write to the group
+ * sub-address, so the axes start with no skew. Every member must be stopped with its next command
+ * queued and preloaded. The control register is common to the group, so all the commands must
+ * turn in the same direction.
+ * 
+ * @param group MOTOR_GROUP_1..3
+ * @return int 0 if started, -1 if a member is not ready or the directions differ
+ */
+int  board_2004_01_V01::groupStepperStart(unsigned char group){
+    const unsigned char groupAddress[] = {0, PCA9629_SUBADR1, PCA9629_SUBADR2, PCA9629_SUBADR3};
+    int direction = MOTOR_STOP;
+    int commandDirection;
+    MOTION_QUEUE *queue;
+    unsigned char i;
+
+    if(group == MOTOR_GROUP_NONE || group > MOTOR_GROUP_3)
+        return -1;
+
+    for(i=0; i<BOARD_MOTOR_CHANNELS; i++){
+        queue = &MOTOR_QUEUE[i];
+        if(queue->group != group)
+            continue;
+
+        if(!queue->count || queue->runningDirection != MOTOR_STOP)
+            return -1;
+
+        commandDirection = (queue->command[queue->head].speed < 0) ? MOTOR_CCW : MOTOR_CW;
+        if(queue->stagedDirection != commandDirection)
+            return -1;
+
+        if(direction == MOTOR_STOP)
+            direction = commandDirection;
+        else if(direction != commandDirection)
+            return -1;
+    }
+
+    // Empty group
+    if(direction == MOTOR_STOP)
+        return -1;
+
+    // Back to single action mode after a continuous rotation or a stop
+    for(i=0; i<BOARD_MOTOR_CHANNELS; i++){
+        if(MOTOR_QUEUE[i].group == group && MOTOR_QUEUE[i].continuousAction){
+            PCA9629_StepperMotorControl(&MOTOR_CHANNEL[i], 0x00);
+            PCA9629_StepperMotorMode(&MOTOR_CHANNEL[i], 0x01);
+            MOTOR_QUEUE[i].continuousAction = false;
+        }
+    }
+
+    if(direction == MOTOR_CCW)
+        PCA9629_BroadcastMotorControl(groupAddress[group], 0x81);
+    else
+        PCA9629_BroadcastMotorControl(groupAddress[group], 0x80);
+
+    for(i=0; i<BOARD_MOTOR_CHANNELS; i++){
+        if(MOTOR_QUEUE[i].group == group)
+            startedHeadRotation(&MOTOR_CHANNEL[i], &MOTOR_QUEUE[i]);
+    }
+    return 0;
+}
+
+/**
+ * @brief Emergency stop of every motor with one write to the all call address
+ */
+void  board_2004_01_V01::stopAllSteppers(void){
+    unsigned char i;
+
+    PCA9629_BroadcastMotorControl(PCA9629_ALLCALLADR, 0x20);
+
+    for(i=0; i<BOARD_MOTOR_CHANNELS; i++){
+        flushStepperQueue(i);
+        MOTOR_QUEUE[i].runningDirection = MOTOR_STOP;
+        MOTOR_QUEUE[i].continuousAction = true;
     }
+}
+
+
+/**
+ * @brief Read the motor state register of the PCA9629A
+ * 
+ * @param motorNumber motor number
+ * @return int STEPPER_STOPPED or STEPPER_RUNNING, -1 if the motor is not fitted
+ */
+int  board_2004_01_V01::getStepperState(unsigned char motorNumber){
+    device_pca9629 *selectedMotor;
+    MOTION_QUEUE *queue;
+    int channel = channelIndex(motorNumber);
+
+    if(channel < 0)
+        return -1;
+    selectedMotor = &MOTOR_CHANNEL[channel];
+    queue = &MOTOR_QUEUE[channel];
 
     int state = (actuator_getStepperState(selectedMotor) & 0x80);
+
+    // Motor stopped, the registers of both directions are free for the next queued command
+    if(state == 0){
+        queue->runningDirection = MOTOR_STOP;
+        stageQueuedRotation(selectedMotor, queue);
+    }
     return state;
 }
 
+/**
+ * @brief Get the motor state without polling the PCA9629A while the move is predicted to be running.
+ * The state register is read only from MOTION_POLL_GUARD_MS before the predicted end of the move,
+ * a move still running after the timeout margin is stopped and reported.
+ * 
+ * @param motorNumber motor number
+ * @return int STEPPER_STOPPED, STEPPER_RUNNING or STEPPER_TIMEOUT (the motor has been stopped),
+ * -1 (STEPPER_TIMEOUT) as well if the motor is not fitted
+ */
+int  board_2004_01_V01::getPredictedStepperState(unsigned char motorNumber){
+    device_pca9629 *selectedMotor;
+    MOTION_QUEUE *queue;
+    long remaining;
+    int state;
+    int channel = channelIndex(motorNumber);
+
+    if(channel < 0)
+        return -1;
+    selectedMotor = &MOTOR_CHANNEL[channel];
+    queue = &MOTOR_QUEUE[channel];
+
+    // Already seen stopped, no move started since
+    if(queue->runningDirection == MOTOR_STOP)
+        return STEPPER_STOPPED;
+
+    // No prediction for the continuous rotations
+    if(queue->continuousAction)
+        return getStepperState(motorNumber);
+
+    remaining = (long)(queue->moveDuration_ms - (millis() - queue->moveStart_ms));
+    if(remaining > MOTION_POLL_GUARD_MS)
+        return STEPPER_RUNNING;
+
+    state = getStepperState(motorNumber);
+    if(state != STEPPER_STOPPED && -remaining > (long)(MOTION_TIMEOUT_MS + (queue->moveDuration_ms * MOTION_TIMEOUT_PERCENT) / 100)){
+        // Move overrun, emergency stop
+        PCA9629_StepperMotorControl(selectedMotor, 0x20);
+        queue->runningDirection = MOTOR_STOP;
+        queue->continuousAction = true;
+        queue->timeoutCount++;
+        return STEPPER_TIMEOUT;
+    }
+    return state;
+}
+
+/**
+ * @brief Number of moves of the motor stopped because they overrun the prediction, 0 if the motor
+ * is not fitted
+ */
+unsigned int  board_2004_01_V01::getStepperTimeoutCount(unsigned char motorNumber){
+    int channel = channelIndex(motorNumber);
+
+    if(channel < 0)
+        return 0;
+    return MOTOR_QUEUE[channel].timeoutCount;
+}
+
+/**
+ * @brief Save the start time and the predicted duration of a single action. One step lasts
+ * (pulse width + 1) x 3us x 2^prescaler, both read from the CWPW/CCWPW value written: the
+ * prescaler is in the bits 15:13, set by actuator_getStepperPulseWidthReg() from
+ * PCA_9629A_CLK_PRESCALER_REGVALUE.
+ */
+void  board_2004_01_V01::predictMoveEnd(MOTION_QUEUE *queue, int speed, int steps){
+    unsigned int pulseWidthReg = actuator_getStepperPulseWidthReg(speed);
+    unsigned long stepPeriod_us = ((pulseWidthReg & 0x1FFF) + 1) * (3UL << (pulseWidthReg >> 13));
+
+    queue->moveStart_ms = millis();
+    if(steps > 0)
+        queue->moveDuration_ms = (stepPeriod_us * steps + 999) / 1000;
+    else
+        queue->moveDuration_ms = 0;
+}
+
 int  board_2004_01_V01::setStepperDriveMode(char motorNumber, unsigned char driveMode){
 
     device_pca9629 *selectedMotor;
+    int channel = channelIndex(motorNumber);
 
+    if(channel < 0)
+        return -1;
     if(driveMode == 0)
         driveMode = 1;      // Two phase drive (full step)
     else driveMode = 2;     // Half step drive
 
-    switch (motorNumber){
-    case 0: selectedMotor = &CHANNEL_A_MOTOR; break;
-    default: selectedMotor = &CHANNEL_A_MOTOR; break;
-    }
+    selectedMotor = &MOTOR_CHANNEL[channel];
+
+    // Keep the mode for a next pca9629_init()
+    if(driveMode == 2)
+        selectedMotor->bipolar_mode = MOTOR_MODE_BIPOLAR_HALF_STEP;
+    else selectedMotor->bipolar_mode = MOTOR_MODE_BIPOLAR;
 
     actuator_setStepperDriveMode(selectedMotor, driveMode);
     return (0);
@@ -4,19 +4,81 @@
 #include <Arduino.h>
 //Low level device hardware library
 #include "device_drivers/src/pca9629.h"
+#include "CONFIG_2004_01_V1.h"
 
 #define MOTOR_A 0
+#define MOTOR_B 1
+#define MOTOR_C 2
+
+// Synchronised start groups, answering to the PCA9629A sub-addresses 1..3
+#define MOTOR_GROUP_NONE 0
+#define MOTOR_GROUP_1 1
+#define MOTOR_GROUP_2 2
+#define MOTOR_GROUP_3 3
+
+// Number of motion commands that can wait behind the running one
+#define MOTION_QUEUE_SIZE 4
+
+// The motor state register is only polled from MOTION_POLL_GUARD_MS before the predicted end of move
+#define MOTION_POLL_GUARD_MS 2
+// A move still running MOTION_TIMEOUT_MS (+ MOTION_TIMEOUT_PERCENT of its duration) after its
+// predicted end is stopped and reported as fault
+#define MOTION_TIMEOUT_MS 200
+#define MOTION_TIMEOUT_PERCENT 25
+
+#define STEPPER_STOPPED 0
+#define STEPPER_RUNNING 0x80
+#define STEPPER_TIMEOUT -1
+
+// Motion command waiting in the queue
+typedef struct motionCommand{
+    int speed;                  // Speed in %, the sign gives the direction
+    int steps;                  // Number of steps to do (single action only)
+} MOTION_COMMAND;
+
+// Motion command queue of one motor channel
+typedef struct motionQueue{
+    MOTION_COMMAND command[MOTION_QUEUE_SIZE];
+    unsigned char head;         // Index of the next command to start
+    unsigned char count;        // Number of commands in the queue
+    char stagedDirection;       // Direction registers preloaded with the head command, MOTOR_STOP if none
+    char runningDirection;      // Direction of the last action started, MOTOR_STOP if stopped
+    bool continuousAction;      // The last action was continuous or stopped, MCNTL and PMA must be reset
+    unsigned long moveStart_ms;     // Start time of the running single action
+    unsigned long moveDuration_ms;  // Predicted duration of the running single action
+    unsigned int timeoutCount;      // Number of moves stopped because they overrun the prediction
+    unsigned char group;            // Synchronised start group of the channel, MOTOR_GROUP_NONE if none
+} MOTION_QUEUE;
 
 class board_2004_01_V01{
     public:
         board_2004_01_V01(void);
         void begin(void);
         int getStepperState(unsigned char motorNumber);
+        int getPredictedStepperState(unsigned char motorNumber);
+        unsigned int getStepperTimeoutCount(unsigned char motorNumber);
         void stepperRotation(char motor, int speed, int steps);
         int setStepperDriveMode(char motorNumber, unsigned char driveMode);
 
+        int queueStepperRotation(char motor, int speed, int steps);
+        int startQueuedRotation(char motor);
+        int getQueuedRotationCount(char motor);
+        void flushStepperQueue(char motor);
+
+        int setStepperGroup(char motor, unsigned char group);
+        int groupStepperStart(unsigned char group);
+        void stopAllSteppers(void);
+
     protected:
-    device_pca9629 CHANNEL_A_MOTOR;
+    device_pca9629 MOTOR_CHANNEL[BOARD_MOTOR_CHANNELS];
+    MOTION_QUEUE MOTOR_QUEUE[BOARD_MOTOR_CHANNELS];
+
+    private:
+        int channelIndex(unsigned char motor);
+        void startedHeadRotation(device_pca9629 *selectedMotor, MOTION_QUEUE *queue);
+        void stageQueuedRotation(device_pca9629 *selectedMotor, MOTION_QUEUE *queue);
+        void startHeadRotation(device_pca9629 *selectedMotor, MOTION_QUEUE *queue);
+        void predictMoveEnd(MOTION_QUEUE *queue, int speed, int steps);
 };
 
 #endif
\ No newline at end of file
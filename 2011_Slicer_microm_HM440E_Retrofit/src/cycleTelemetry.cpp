@@ -0,0 +1,105 @@
+/**
+ * @file cycleTelemetry.cpp
+ * @brief Ring buffer of the cycle phase time stamps, the rate and latencies are averaged over the
+ *        complete cycles of the buffer.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - ring buffer of the phase time stamps
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "cycleTelemetry.h"
+
+/**
+ * @brief Event recorded i events after the oldest one
+ */
+static CYCLE_EVENT *eventAt(CYCLE_TELEMETRY *telemetry, unsigned char i){
+  return &telemetry->event[(telemetry->head - telemetry->count + i) & (TELEMETRY_SIZE-1)];
+}
+
+/**
+ * @brief Clear the recorded events
+ *
+ * @param telemetry pointer to the telemetry buffer
+ */
+void telemetry_init(CYCLE_TELEMETRY *telemetry){
+  telemetry->head = 0;
+  telemetry->count = 0;
+}
+
+/**
+ * @brief Record a cycle phase, the oldest event is overwritten when the buffer is full
+ *
+ * @param telemetry pointer to the telemetry buffer
+ * @param phase PHASE_xxx
+ * @param time_ms time stamp
+ */
+void telemetry_record(CYCLE_TELEMETRY *telemetry, unsigned char phase, unsigned long time_ms){
+  telemetry->event[telemetry->head].phase = phase;
+  telemetry->event[telemetry->head].time_ms = time_ms;
+  telemetry->head = (telemetry->head+1) & (TELEMETRY_SIZE-1);
+  if(telemetry->count < TELEMETRY_SIZE)
+    telemetry->count++;
+}
+
+/**
+ * @brief Stroke rate over the recorded cut starts
+ *
+ * @param telemetry pointer to the telemetry buffer
+ * @return unsigned int strokes per minute, 0 if less than 2 strokes recorded
+ */
+unsigned int telemetry_strokesPerMinute(CYCLE_TELEMETRY *telemetry){
+  unsigned char i;
+  unsigned int strokes = 0;
+  unsigned long first = 0;
+  unsigned long last = 0;
+  CYCLE_EVENT *event;
+
+  for(i=0;i<telemetry->count;i++){
+    event = eventAt(telemetry, i);
+    if(event->phase != PHASE_CUT_START)
+      continue;
+    if(!strokes)
+      first = event->time_ms;
+    last = event->time_ms;
+    strokes++;
+  }
+  if(strokes < 2 || last == first)
+    return 0;
+  return (strokes-1) * 60000UL / (last - first);
+}
+
+/**
+ * @brief Mean time between a phase and the next end phase, over the recorded cycles
+ *        (PHASE_REWIND to PHASE_RETRACT_DONE for the retraction, PHASE_CUT_START to PHASE_ADVANCE_DONE for the advance)
+ *
+ * @param telemetry pointer to the telemetry buffer
+ * @param startPhase PHASE_xxx starting the measure
+ * @param endPhase PHASE_xxx ending the measure
+ * @return int mean latency [ms], -1 if no complete measure recorded
+ */
+int telemetry_latency_ms(CYCLE_TELEMETRY *telemetry, unsigned char startPhase, unsigned char endPhase){
+  unsigned char i;
+  unsigned int measures = 0;
+  unsigned long sum = 0;
+  unsigned long start = 0;
+  bool started = false;
+  CYCLE_EVENT *event;
+
+  for(i=0;i<telemetry->count;i++){
+    event = eventAt(telemetry, i);
+    if(event->phase == startPhase){
+      start = event->time_ms;
+      started = true;
+    }else if(event->phase == endPhase && started){
+      sum += event->time_ms - start;
+      measures++;
+      started = false;
+    }
+  }
+  if(!measures)
+    return -1;
+  return sum / measures;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file cycleTelemetry.h
+ * @brief Time stamps of the cutting cycle phases kept in a RAM ring buffer. The stroke rate and
+ *        the retraction and advance latencies are derived from the last cycles recorded.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - phase time stamps of the cutting cycle for the diagnostics screen
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef cycleTelemetry_h
+#define cycleTelemetry_h
+
+// Number of phase events kept, power of 2 (4 events per cycle with retraction)
+#define TELEMETRY_SIZE 32
+
+// Cutting cycle phases
+#define PHASE_CUT_START 0           // Threshold to cut crossed, the blade cuts
+#define PHASE_REWIND 1              // Threshold to rewind crossed, the blade goes up
+#define PHASE_RETRACT_DONE 2        // End of the specimen retraction
+#define PHASE_ADVANCE_DONE 3        // End of the specimen advance
+
+typedef struct t_cycleEvent{
+    unsigned long time_ms;
+    unsigned char phase;
+} CYCLE_EVENT;
+
+typedef struct t_cycleTelemetry{
+    CYCLE_EVENT event[TELEMETRY_SIZE];
+    unsigned char head;             // Next slot written
+    unsigned char count;            // Number of events recorded
+} CYCLE_TELEMETRY;
+
+extern void telemetry_init(CYCLE_TELEMETRY *telemetry);
+extern void telemetry_record(CYCLE_TELEMETRY *telemetry, unsigned char phase, unsigned long time_ms);
+extern unsigned int telemetry_strokesPerMinute(CYCLE_TELEMETRY *telemetry);
+extern int telemetry_latency_ms(CYCLE_TELEMETRY *telemetry, unsigned char startPhase, unsigned char endPhase);
+
+#endif
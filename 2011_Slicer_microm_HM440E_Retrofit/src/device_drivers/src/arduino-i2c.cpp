@@ -12,9 +12,11 @@
 #include "arduino-i2c.h"
 #include <Arduino.h>
 #include <Wire.h>
+#include "../../i2cTrace.h"
 
 int i2c_write(unsigned char bus, unsigned char devAddr, unsigned char reg, unsigned char data){
 
+    I2C_TRACE_TRANSFER(I2C_TRACE_WRITE, devAddr, reg, 1);
     Wire.beginTransmission(devAddr); // Select device address
     Wire.write(reg);                 // Select register data
     Wire.write(data);                // sends data
@@ -24,6 +26,7 @@ int i2c_write(unsigned char bus, unsigned char devAddr, unsigned char reg, unsig
 }
 
 int i2c_writeBuffer(unsigned char bus, unsigned char devAddr, unsigned char reg, unsigned char * data, unsigned char count){
+    I2C_TRACE_TRANSFER(I2C_TRACE_WRITE, devAddr, reg, count);
     Wire.beginTransmission(devAddr); // Select device address
     Wire.write(reg);                 // Select register data
     Wire.write(data, count);
@@ -33,6 +36,7 @@ int i2c_writeBuffer(unsigned char bus, unsigned char devAddr, unsigned char reg,
 }
 
 int i2c_writeRaw(unsigned char bus, unsigned char devAddr, unsigned char * data, unsigned char count){
+    I2C_TRACE_TRANSFER(I2C_TRACE_RAW_WRITE, devAddr, 0, count);
     Wire.beginTransmission(devAddr); // Select device address
     Wire.write(data, count);
     Wire.endTransmission();          // stop transmitting
@@ -42,6 +46,7 @@ int i2c_writeRaw(unsigned char bus, unsigned char devAddr, unsigned char * data,
 
 int i2c_readByte(unsigned char bus, unsigned char devAddr, unsigned char reg, unsigned char * ptrDest){     
     
+    I2C_TRACE_TRANSFER(I2C_TRACE_READ, devAddr, reg, 1);
     Wire.beginTransmission(devAddr);
     Wire.write(reg);                   //  The command byte, sets pointer to register with address of 0x32
     Wire.endTransmission();
@@ -57,6 +62,7 @@ int i2c_readByte(unsigned char bus, unsigned char devAddr, unsigned char reg, un
 int i2c_read(unsigned char bus, unsigned char devAddr, unsigned char reg, unsigned char * data, unsigned char count){
     unsigned char i=0;
 
+    I2C_TRACE_TRANSFER(I2C_TRACE_READ, devAddr, reg, count);
     Wire.beginTransmission(devAddr);
     Wire.write(reg);                   //  The command byte, sets pointer to register with address of 0x32
     Wire.endTransmission();
@@ -73,6 +79,7 @@ int i2c_read(unsigned char bus, unsigned char devAddr, unsigned char reg, unsign
 int i2c_readRaw(unsigned char bus, unsigned char devAddr, unsigned char * data, unsigned char count){
     unsigned char i=0;
 
+    I2C_TRACE_TRANSFER(I2C_TRACE_RAW_READ, devAddr, 0, count);
     Wire.requestFrom(devAddr, count);    // request n bytes from slave device #devAddr
     while(Wire.available())    // slave may send less than requested
     {
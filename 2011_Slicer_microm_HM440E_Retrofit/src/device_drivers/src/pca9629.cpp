@@ -33,10 +33,12 @@ int pca9629_init(device_pca9629 *pca9629config){
     
     unsigned char OP_CFG_PHS_DATA = 0x10;
 
-    if(pca9629config->bipolar_mode)
-        OP_CFG_PHS_DATA |= 0x40;
+    if(pca9629config->bipolar_mode == MOTOR_MODE_BIPOLAR_HALF_STEP)
+        OP_CFG_PHS_DATA |= 0xC0;                // Two phase half step drive
+    else if(pca9629config->bipolar_mode)
+        OP_CFG_PHS_DATA |= 0x40;                // Two phase drive
         
-    err+= i2c_write(0, devAddress, 0x00, 0x20);    // MODE - Configuration du registre MODE (pin INT désactivée, Allcall Adr. désactivé)
+    err+= i2c_write(0, devAddress, 0x00, PCA9629_MODE_DEFAULT);    // MODE - Configuration du registre MODE (pin INT désactivée, Allcall Adr. désactivé)
     err+= i2c_write(0, devAddress, 0x01, 0xFF);    // WDTOI
     err+= i2c_write(0, devAddress, 0x02, 0x00);    // WDCNTL
     err+= i2c_write(0, devAddress, 0x03, 0x0F);    // IO_CFG
@@ -64,10 +66,10 @@ int pca9629_init(device_pca9629 *pca9629config){
     err+= i2c_write(0, devAddress, 0x18, 0x4D);    // CCWPWL - Vitesse / Largeur d'impulsion pour CCW (1mS)
     err+= i2c_write(0, devAddress, 0x19, 0x01);    // CCWPWH
     err+= i2c_write(0, devAddress, 0x1A, 0x00);    // MCNTL - Registre contrôle moteur
-    err+= i2c_write(0, devAddress, 0x1B, 0xE2);    // SUBA1
-    err+= i2c_write(0, devAddress, 0x1C, 0xE4);    // SUBA2
-    err+= i2c_write(0, devAddress, 0x1D, 0xE8);    // SUBA3
-    err+= i2c_write(0, devAddress, 0x1E, 0xE0);    // ALLCALLA
+    err+= i2c_write(0, devAddress, 0x1B, PCA9629_SUBADR1);    // SUBA1
+    err+= i2c_write(0, devAddress, 0x1C, PCA9629_SUBADR2);    // SUBA2
+    err+= i2c_write(0, devAddress, 0x1D, PCA9629_SUBADR3);    // SUBA3
+    err+= i2c_write(0, devAddress, 0x1E, PCA9629_ALLCALLADR);    // ALLCALLA
     //err+= i2c_write(0, PCA9629, 0x1F, 0x00);    // STEPCOUNT0
     //err+= i2c_write(0, PCA9629, 0x20, 0x00);    // STEPCOUNT1
     //err+= i2c_write(0, PCA9629, 0x21, 0x00);    // STEPCOUNT2
@@ -97,6 +99,35 @@ int PCA9629_StepperMotorControl(device_pca9629 *pca9629config, int data){
 }
 
 
+/**
+ * \brief PCA9629_BroadcastMotorControl, Set the control register of every motor answering to
+ * a sub-address or to the all call address, in a single I2C write
+ * \param subAddress sub-address or all call address (8 bit format)
+ * \return code error
+ */
+
+int PCA9629_BroadcastMotorControl(unsigned char subAddress, int data){
+   	unsigned char err=0;
+
+        err += i2c_write(0, subAddress >> 1, 0x1a, data & 0x00FF);
+        
+        return(err);
+}
+
+/**
+ * \brief PCA9629_ModeConfig, Set the MODE register (sub-addresses and all call enable)
+ * \param handler to PCA9629 configuration structure
+ * \return code error
+ */
+
+int PCA9629_ModeConfig(device_pca9629 *pca9629config, unsigned char data){
+   	unsigned char err=0;
+    unsigned char devAddress = pca9629config->deviceAddress;
+
+    err+= i2c_write(0, devAddress, 0x00, data);         //  MODE
+    return(err);
+}
+
 /**
  * \brief int PCA9629_StepperMotorSetStep, Set the number of step to do in CW and CCW direction
  * \param handler to PCA9629 configuration structure
@@ -119,6 +150,29 @@ int PCA9629_StepperMotorSetStep(device_pca9629 *pca9629config, int stepCount){
 	return(err);
 }
 
+/**
+ * \brief int PCA9629_StepperMotorSetStepDir, Set the number of step to do in one direction only.
+ * The registers of the other direction are not modified and can be used by a running action
+ * \param handler to PCA9629 configuration structure
+ * \param direction MOTOR_CW or MOTOR_CCW
+ * \return code error
+ */
+
+int PCA9629_StepperMotorSetStepDir(device_pca9629 *pca9629config, int direction, int stepCount){
+   	unsigned char err=0;
+    unsigned char regAddress = 0x12;                                   // CWSCOUNTL
+
+    unsigned char devAddress = pca9629config->deviceAddress;
+
+    if(direction == MOTOR_CCW)
+        regAddress = 0x14;                                             // CCWSCOUNTL
+
+    err += i2c_write(0, devAddress, regAddress, stepCount&0x00FF);           // Défini le nombre de pas dans le registre LOW
+    err += i2c_write(0, devAddress, regAddress+1, (stepCount&0xFF00)>>8);    // Défini le nombre de pas dans le registre HIGH
+
+	return(err);
+}
+
 /**
  * \brief int PCA9629_ReadMotorState, Get the actual state of the motor
  * \param handler to PCA9629 configuration structure
@@ -182,6 +236,28 @@ int PCA9629_StepperMotorPulseWidth(device_pca9629 *pca9629config, int data){
         return(err);
 }
 
+/**
+ * \brief int PCA9629_StepperMotorPulseWidthDir, Set the pulse width in one direction only.
+ * The registers of the other direction are not modified and can be used by a running action
+ * \param handler to PCA9629 configuration structure
+ * \param direction MOTOR_CW or MOTOR_CCW
+ * \return code error
+ */
+
+int PCA9629_StepperMotorPulseWidthDir(device_pca9629 *pca9629config, int direction, int data){
+   	unsigned char err=0;
+    unsigned char regAddress = 0x16;                                   // CWPWL
+
+    unsigned char devAddress = pca9629config->deviceAddress;
+
+    if(direction == MOTOR_CCW)
+        regAddress = 0x18;                                             // CCWPWL
+
+    err+= i2c_write(0, devAddress, regAddress, data & 0x00FF);         // xxPWL - Vitesse / Largeur d'impulsion
+    err+= i2c_write(0, devAddress, regAddress+1, (data & 0xFF00)>>8);  // xxPWH
+    return(err);
+}
+
  int PCA9629_StepperDriveMode(device_pca9629 *pca9629config, unsigned char data){
    	unsigned char err=0;
     unsigned char devAddress = pca9629config->deviceAddress;
@@ -211,6 +287,19 @@ int PCA9629_StepperMotorPulseWidth(device_pca9629 *pca9629config, int data){
  */
 
 int actuator_setStepperSpeed(device_pca9629 *pca9629config, int speed){
+    PCA9629_StepperMotorPulseWidth(pca9629config, actuator_getStepperPulseWidthReg(speed));
+    return (1);
+}
+
+/*
+ * \fn int actuator_getStepperPulseWidthReg()
+ * \brief Convert a speed ratio to the PCA9629A pulse width register value
+ *
+ * \param speed 0..100%
+ * \return pulse width register value, prescaler included
+ */
+
+int actuator_getStepperPulseWidthReg(int speed){
    long regData;
    float mappingResult;
 
@@ -228,8 +317,8 @@ int actuator_setStepperSpeed(device_pca9629 *pca9629config, int speed){
     // ROUND(    (mS*1000)/(3uS*(2^PRESCALE VALUE))-1             )
      regData = (mappingResult * 1000.0)/(3*pow(2,PCA_9629A_CLK_PRESCALER_REGVALUE))-1;    
     
-    PCA9629_StepperMotorPulseWidth(pca9629config, regData);
-    return (1);
+    // the prescaler the value is computed with, in the bits 15:13 of CWPW/CCWPW
+    return regData | ((long)PCA_9629A_CLK_PRESCALER_REGVALUE << 13);
 }
 
 
@@ -287,6 +376,41 @@ int actuator_setStepperStepAction(device_pca9629 *pca9629config, int direction,
     return (0);
 } 
 
+/**
+ * \fn char actuator_stageStepperStepAction()
+ * \brief Preload the speed and step count of a single action in the registers of its direction,
+ * without starting it. Use actuator_startStepperStepAction() to start the staged action.
+ *
+ * \param direction MOTOR_CW or MOTOR_CCW
+ * \param speed 0..100%
+ * \param stepCount number of steps (>0)
+ * \return code error
+ */
+
+int actuator_stageStepperStepAction(device_pca9629 *pca9629config, int direction, int speed, int stepCount){
+    int err=0;
+
+    err += PCA9629_StepperMotorPulseWidthDir(pca9629config, direction, actuator_getStepperPulseWidthReg(speed));
+    err += PCA9629_StepperMotorSetStepDir(pca9629config, direction, stepCount);
+    return err;
+}
+
+/**
+ * \fn char actuator_startStepperStepAction()
+ * \brief Start a single action preloaded with actuator_stageStepperStepAction(),
+ * only the motor control register is written.
+ *
+ * \param direction MOTOR_CW or MOTOR_CCW
+ * \return code error
+ */
+
+int actuator_startStepperStepAction(device_pca9629 *pca9629config, int direction){
+    if(direction == MOTOR_CCW)
+        return PCA9629_StepperMotorControl(pca9629config, 0x81);        // CCW
+    else
+        return PCA9629_StepperMotorControl(pca9629config, 0x80);        // CW
+}
+
 /**
  * @brief Set the driver mode for stepper motor (One phase, two phases or half-step)
  * 
@@ -21,10 +21,24 @@
 #define MOTOR_MODE_BIPOLAR 1
 #define MOTOR_MODE_BIPOLAR_HALF_STEP 2
 
-#define STEPPER_MIN_PULSEWIDTH_MS     3
-#define STEPPER_MAX_PULSEWIDTH_MS     10
+// MODE register, bits 3..0 enable the answer to the sub-addresses and to the all call address
+#define PCA9629_MODE_DEFAULT    0x20
+#define PCA9629_MODE_SUB1       0x08
+#define PCA9629_MODE_SUB2       0x04
+#define PCA9629_MODE_SUB3       0x02
+#define PCA9629_MODE_ALLCALL    0x01
+
+// Sub-addresses and all call address programmed by pca9629_init() (8 bit format, R/W bit = 0)
+#define PCA9629_SUBADR1         0xE2
+#define PCA9629_SUBADR2         0xE4
+#define PCA9629_SUBADR3         0xE8
+#define PCA9629_ALLCALLADR      0xE0
+
+#define STEPPER_MIN_PULSEWIDTH_MS     1.5
+#define STEPPER_MAX_PULSEWIDTH_MS     5
 // PCA_9629A_CLK_PRESCALER_REGVALUE -> (3 most significant bit) configured for run from STEPPER_MIN_PULSEWIDTH_MS to STEPPER_MAX_PULSEWIDTH_MS (PCA9629A datasheet sheet 27)
-#define PCA_9629A_CLK_PRESCALER_REGVALUE  1     
+// written with the pulse width, 0: 3us steps up to 24.6ms
+#define PCA_9629A_CLK_PRESCALER_REGVALUE  0
 
 /**
  * \struct device_pca9629 [pca9629.h] Configuration structure definition
@@ -48,12 +62,17 @@ extern int pca9629_init(device_pca9629 *pca9629config);
 
 
 extern int PCA9629_StepperMotorControl(device_pca9629 *pca9629config, int data);
+extern int PCA9629_BroadcastMotorControl(unsigned char subAddress, int data);                  // Contrôle moteur via sous-adresse / all call
+extern int PCA9629_ModeConfig(device_pca9629 *pca9629config, unsigned char data);              // Configuration du registre MODE
 extern int PCA9629_StepperStepperMode(device_pca9629 *pca9629config, int mode);
+extern int PCA9629_StepperMotorMode(device_pca9629 *pca9629config, int data);                  // Mode action continue ou unique
 
 
 extern int PCA9629_StepperMotorSetStep(device_pca9629 *pca9629config, int stepCount);         //Configuration du registre "PAS" du driver moteur
+extern int PCA9629_StepperMotorSetStepDir(device_pca9629 *pca9629config, int direction, int stepCount);  // Registre "PAS" d'un seul sens de rotation
 extern int PCA9629_StepperDriveMode(device_pca9629 *pca9629config, unsigned char data);       // Mode action continue ou unique
 extern int PCA9629_StepperMotorPulseWidth(device_pca9629 *pca9629config, int data);           // Définition de la largeur d'impulstion
+extern int PCA9629_StepperMotorPulseWidthDir(device_pca9629 *pca9629config, int direction, int data);   // Largeur d'impulsion d'un seul sens de rotation
 extern int PCA9629_ReadMotorState(device_pca9629 *pca9629config);                             // Lecture du registre de contrôle du moteur
 
 extern int PCA9629_GPIOConfig(device_pca9629 *pca9629config, unsigned char data);             // Configuration du registre GPIO
@@ -67,5 +86,8 @@ extern int actuator_setStepperDriveMode(device_pca9629 *pca9629config, unsigned
 extern int actuator_setStepperSpeed(device_pca9629 *pca9629config, int speed);
 extern int actuator_setStepperStepAction(device_pca9629 *pca9629config, int direction, int stepCount);
 extern int actuator_getStepperState(device_pca9629 *pca9629config);
+extern int actuator_getStepperPulseWidthReg(int speed);
+extern int actuator_stageStepperStepAction(device_pca9629 *pca9629config, int direction, int speed, int stepCount);
+extern int actuator_startStepperStepAction(device_pca9629 *pca9629config, int direction);
 
 #endif /* PCA9629_H */
\ No newline at end of file
@@ -0,0 +1,106 @@
+/**
+ * @file i2cTrace.cpp
+ * @brief Recording of the I2C transfers: RAM ring buffer dumped over the serial port on the target,
+ *        one line per transfer in the trace file on the host.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - trace records of the target and of the host
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stdio.h>
+#include "i2cTrace.h"
+
+#ifdef I2C_TRACE
+
+// Longest line of a record
+#define I2C_TRACE_LINE_SIZE 32
+
+#ifdef ARDUINO_ARCH_SAMD
+static I2C_TRACE_RECORD records[I2C_TRACE_SIZE];
+static unsigned int head = 0;           // Next slot written
+static unsigned int count = 0;          // Number of records kept
+#else
+static FILE *traceFile = NULL;
+#endif
+
+/**
+ * @brief Text line of a record, terminated by a new line
+ */
+static void formatRecord(const I2C_TRACE_RECORD *record, char *line){
+  if(record->kind == I2C_TRACE_CYCLE)
+    snprintf(line, I2C_TRACE_LINE_SIZE, "%lu C\n", record->time_us);
+  else if(record->kind == I2C_TRACE_RAW_WRITE || record->kind == I2C_TRACE_RAW_READ)
+    snprintf(line, I2C_TRACE_LINE_SIZE, "%lu %c %02x -- %u\n", record->time_us, record->kind, record->device, record->length);
+  else
+    snprintf(line, I2C_TRACE_LINE_SIZE, "%lu %c %02x %02x %u\n", record->time_us, record->kind, record->device, record->reg, record->length);
+}
+
+/**
+ * @brief Record a transfer at the current time, the oldest record is overwritten when the
+ *        buffer is full
+ *
+ * @param kind I2C_TRACE_xxx
+ * @param device 7 bit address
+ * @param reg register, not used for the transfers without register
+ * @param length data bytes
+ */
+void i2cTrace_record(unsigned char kind, unsigned char device, unsigned char reg, unsigned char length){
+  I2C_TRACE_RECORD record;
+
+  record.time_us = micros();
+  record.kind = kind;
+  record.device = device;
+  record.reg = reg;
+  record.length = length;
+#ifdef ARDUINO_ARCH_SAMD
+  noInterrupts();
+  records[head] = record;
+  head = (head+1) & (I2C_TRACE_SIZE-1);
+  if(count < I2C_TRACE_SIZE)
+    count++;
+  interrupts();
+#else
+  char line[I2C_TRACE_LINE_SIZE];
+
+  if(!traceFile){
+    const char *name = getenv("I2C_TRACE_FILE");
+
+    traceFile = fopen(name ? name : I2C_TRACE_FILE, "w");
+    if(!traceFile)
+      return;
+  }
+  formatRecord(&record, line);
+  fputs(line, traceFile);
+#endif
+}
+
+/**
+ * @brief Send the records kept, oldest first, and clear them. On the host the records are
+ *        already in the trace file, which is flushed.
+ *
+ * @param out serial port
+ */
+void i2cTrace_dump(Print *out){
+#ifdef ARDUINO_ARCH_SAMD
+  I2C_TRACE_RECORD record;
+  char line[I2C_TRACE_LINE_SIZE];
+
+  while(count){
+    noInterrupts();
+    record = records[(head - count) & (I2C_TRACE_SIZE-1)];
+    count--;
+    interrupts();
+    formatRecord(&record, line);
+    out->print(line);
+  }
+#else
+  (void)out;
+  if(traceFile)
+    fflush(traceFile);
+#endif
+}
+
+#endif
@@ -0,0 +1,57 @@
+/**
+ * @file i2cTrace.h
+ * @brief Trace of the I2C transfers of the drivers (arduino-i2c, LiquidCrystal_I2C), built with
+ *        -DI2C_TRACE only. Each transfer is recorded with its time, device, register and length:
+ *        in a RAM ring buffer sent over the serial port on the target, in a file on the host
+ *        (I2C_TRACE_FILE environment variable, "i2c_trace.txt" by default). A cycle mark
+ *        separates the cutting cycles, tools/i2c_trace_compare.py compares the transfers of each
+ *        cycle with a golden trace.
+ *
+ *        One line per record: time_us kind device register length, kind W register write,
+ *        R register read, w write without register, r read without register, C cycle mark.
+ *        The device and the register are in hexadecimal, "--" without register.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - trace of the I2C transfers against a golden trace
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef i2cTrace_h
+#define i2cTrace_h
+
+#include <Arduino.h>
+
+// Number of records kept on the target, power of 2
+#define I2C_TRACE_SIZE 256
+
+// Kinds of record
+#define I2C_TRACE_WRITE 'W'
+#define I2C_TRACE_READ 'R'
+#define I2C_TRACE_RAW_WRITE 'w'
+#define I2C_TRACE_RAW_READ 'r'
+#define I2C_TRACE_CYCLE 'C'
+
+#define I2C_TRACE_FILE "i2c_trace.txt"
+
+#ifdef I2C_TRACE
+#define I2C_TRACE_TRANSFER(kind, device, reg, length) i2cTrace_record(kind, device, reg, length)
+#define I2C_TRACE_CYCLE_MARK() i2cTrace_record(I2C_TRACE_CYCLE, 0, 0, 0)
+#else
+#define I2C_TRACE_TRANSFER(kind, device, reg, length)
+#define I2C_TRACE_CYCLE_MARK()
+#endif
+
+typedef struct t_i2cTraceRecord{
+    unsigned long time_us;
+    unsigned char kind;
+    unsigned char device;
+    unsigned char reg;
+    unsigned char length;           // data bytes written or requested
+} I2C_TRACE_RECORD;
+
+extern void i2cTrace_record(unsigned char kind, unsigned char device, unsigned char reg, unsigned char length);
+extern void i2cTrace_dump(Print *out);
+
+#endif
@@ -0,0 +1,88 @@
+/**
+ * @file inputEvents.cpp
+ * @brief Ring of the input events with a head written by the interrupts only and a tail written by
+ *        the user interface only, the indexes are published after the event.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - single producer / single consumer ring of the knob events
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stddef.h>
+#include "inputEvents.h"
+
+// Events, written by the producer only between tail and head
+static INPUT_EVENT eventQueue[INPUT_EVENTS_SIZE];
+// head is only written by the producer, tail by the consumer
+static volatile unsigned char head=0;
+static volatile unsigned char tail=0;
+static volatile unsigned int overflowCount=0;
+
+/**
+ * @brief Add an event to the queue (producer side, interrupt context)
+ *
+ * @param type EVENT_xxx
+ * @param value event value
+ * @param time_ms time stamp
+ * @return int 0 if queued, -1 if the queue is full (event lost)
+ */
+int inputEvents_push(unsigned char type, signed char value, unsigned long time_ms){
+  unsigned char next = (head+1) & (INPUT_EVENTS_SIZE-1);
+
+  if(next == tail){
+    overflowCount++;
+    return -1;
+  }
+  eventQueue[head].type = type;
+  eventQueue[head].value = value;
+  eventQueue[head].time_ms = time_ms;
+  // the event must be written before it is published
+  __sync_synchronize();
+  head = next;
+  return 0;
+}
+
+/**
+ * @brief Read the oldest event without removing it (consumer side)
+ *
+ * @param event pointer to the event read
+ * @return int 1 if an event was read, 0 if the queue is empty
+ */
+int inputEvents_peek(INPUT_EVENT *event){
+  if(tail == head)
+    return 0;
+  // the event is read after its publication
+  __sync_synchronize();
+  *event = eventQueue[tail];
+  return 1;
+}
+
+/**
+ * @brief Remove the oldest event from the queue (consumer side)
+ *
+ * @param event pointer to the event read, can be NULL
+ * @return int 1 if an event was removed, 0 if the queue is empty
+ */
+int inputEvents_pop(INPUT_EVENT *event){
+  INPUT_EVENT oldest;
+
+  if(!inputEvents_peek(&oldest))
+    return 0;
+  if(event)
+    *event = oldest;
+  // the slot is released after it was read
+  __sync_synchronize();
+  tail = (tail+1) & (INPUT_EVENTS_SIZE-1);
+  return 1;
+}
+
+/**
+ * @brief Number of events lost because the queue was full
+ *
+ * @return unsigned int lost events
+ */
+unsigned int inputEvents_overflowCount(void){
+  return overflowCount;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file inputEvents.h
+ * @brief Lock free single producer / single consumer queue of the user input events. The knob
+ *        interrupts (same priority, they never preempt each other) push the events, the user
+ *        interface pops them in order, so no detent or push is lost between two passes.
+ * @version 0.2
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - knob event queue, replaces the rotation and push flags of the interrupts
+ *         19.10.2026 - all the rotations queued are read in one pass
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef inputEvents_h
+#define inputEvents_h
+
+// Number of events the queue can hold, power of 2
+#define INPUT_EVENTS_SIZE 32
+
+// Event types
+#define EVENT_KNOB_ROTATION 1       // value: knob direction
+#define EVENT_KNOB_PUSH 2           // value: short or long push
+
+typedef struct t_inputEvent{
+    unsigned char type;
+    signed char value;
+    unsigned long time_ms;
+} INPUT_EVENT;
+
+extern int inputEvents_push(unsigned char type, signed char value, unsigned long time_ms);
+extern int inputEvents_peek(INPUT_EVENT *event);
+extern int inputEvents_pop(INPUT_EVENT *event);
+extern unsigned int inputEvents_overflowCount(void);
+
+#endif
@@ -13,6 +13,7 @@
 
 // User application header file
 #include "jsonConfigSDcard.h"
+#include "adcFilter.h"
 
 // SDcard utility libraries
 #include <SPI.h>
@@ -27,9 +28,28 @@
 // Code error declaration
 #define NO_ERROR 0
 
+// Steps of a save spread over several calls of continueSaveUserAndGeneralSettings()
+#define SAVE_IDLE 0
+#define SAVE_OPEN 1
+#define SAVE_WRITE 2
+#define SAVE_CLOSE 3
+
+// Bytes written to the file per call of continueSaveUserAndGeneralSettings()
+#define SAVE_CHUNK_SIZE 512
+
 // Functions declarations
 int loadFileFromSD(char * fileName, char * destinationBuffer);
 int SaveFileToSD(char * fileName, char * sourceBuffer);
+int serializeUserAndGeneralSettings(SLICERCONFIG *machineConfig, SETTINGS * userConfig, unsigned char nbOfUserConfig, char * buffer);
+
+// Save in progress: serialized settings, file and next step
+static char saveBuffer[FILE_BUFFER_SIZE];
+static char * saveFileName;
+static SdFat saveSD;
+static File saveFile;
+static unsigned char saveStep = SAVE_IDLE;
+static unsigned int saveIndex;
+static unsigned int saveLength;
 
 
 /**
@@ -152,12 +172,22 @@ if(loadFileFromSD(fileName, buffer) == NO_ERROR){
       machineConfig->BacklashCW = JSONdoc["General"]["BacklashCW_correction"];
       machineConfig->HomingSpeed = JSONdoc["General"]["HomingSpeed"];
       machineConfig->MovingSpeed = JSONdoc["General"]["MovingSpeed"];
+      machineConfig->PredictLead_ms = JSONdoc["General"]["PredictLead_ms"] | DEFAULT_PREDICT_LEAD_MS;
 
       // get the alarm state from string
       if(!strcmp(JSONdoc["General"]["ScreenBacklight"], "on")){
         machineConfig->ScreenBacklight  = 1;
       }else machineConfig->ScreenBacklight = 0;
 
+      // get the stepper drive mode from string (full step if missing)
+      if(!strcmp(JSONdoc["General"]["DriveMode"] | "full", "half")){
+        machineConfig->DriveMode = DRIVE_MODE_HALF_STEP;
+      }else machineConfig->DriveMode = DRIVE_MODE_FULL_STEP;
+
+      // get the ADC channel filters from string
+      machineConfig->PotFilter = adcFilter_typeFromName(JSONdoc["General"]["PotFilter"], ADC_FILTER_MEDIAN);
+      machineConfig->NtcFilter = adcFilter_typeFromName(JSONdoc["General"]["NtcFilter"], ADC_FILTER_AVERAGE);
+
       #ifdef SERIAL_DEBUG
       Serial.println("Machine config\n------------");
       Serial.println(machineConfig->BacklashCCW);
@@ -165,6 +195,10 @@ if(loadFileFromSD(fileName, buffer) == NO_ERROR){
       Serial.println(machineConfig->HomingSpeed);
       Serial.println(machineConfig->MovingSpeed);
       Serial.println(machineConfig->ScreenBacklight);
+      Serial.println(machineConfig->DriveMode);
+      Serial.println(machineConfig->PredictLead_ms);
+      Serial.println(machineConfig->PotFilter);
+      Serial.println(machineConfig->NtcFilter);
 
       #endif
       return 0;
@@ -243,15 +277,106 @@ SdFat SD;
  */
 int saveUserAndGeneralSettings(char * fileName, SLICERCONFIG *machineConfig, SETTINGS * userConfig, unsigned char nbOfUserConfig){
 
+// Buffer for data string for JSON serializazion
+char buffer[FILE_BUFFER_SIZE];
+
+serializeUserAndGeneralSettings(machineConfig, userConfig, nbOfUserConfig, buffer);
+
+if(SaveFileToSD(fileName, buffer) == 0)
+  return 0;
+else return -1;
+}
+
+/**
+ * @brief Start a save of the general setting and the users settings written by the next calls of
+ * continueSaveUserAndGeneralSettings(), one step per call, so that the caller keeps running
+ * between the steps. The settings are serialized now, a save in progress is restarted.
+ * 
+ * @param fileName to save, must stay valid until the end of the save
+ * @param machineConfig pointer to machineConfig structure
+ * @param userConfig pointer to users settings structure
+ * @param nbOfUserConfig number of users settings to save
+ */
+void beginSaveUserAndGeneralSettings(char * fileName, SLICERCONFIG *machineConfig, SETTINGS * userConfig, unsigned char nbOfUserConfig){
+if(saveStep == SAVE_WRITE || saveStep == SAVE_CLOSE)
+  saveFile.close();
+
+saveLength = serializeUserAndGeneralSettings(machineConfig, userConfig, nbOfUserConfig, saveBuffer);
+saveFileName = fileName;
+saveIndex = 0;
+saveStep = SAVE_OPEN;
+}
+
+/**
+ * @brief Next step of the save started by beginSaveUserAndGeneralSettings(): card and file
+ * opening, SAVE_CHUNK_SIZE bytes written, or file closing
+ * 
+ * @return int 1 if the save goes on, 0 if done or no save in progress, -1 if the save failed
+ */
+int continueSaveUserAndGeneralSettings(void){
+unsigned int count;
+
+switch(saveStep){
+  case SAVE_OPEN:
+    if(!saveSD.begin(SD_CS_PIN)){
+      saveStep = SAVE_IDLE;
+      return -1;
+    }
+    saveFile = saveSD.open(saveFileName, FILE_WRITE);
+    if(!saveFile){
+      saveStep = SAVE_IDLE;
+      return -1;
+    }
+    saveFile.rewind();
+    saveStep = SAVE_WRITE;
+    return 1;
+
+  case SAVE_WRITE:
+    count = saveLength - saveIndex;
+    if(count > SAVE_CHUNK_SIZE)
+      count = SAVE_CHUNK_SIZE;
+    saveFile.write((const uint8_t *)saveBuffer + saveIndex, count);
+    saveIndex += count;
+    if(saveIndex >= saveLength)
+      saveStep = SAVE_CLOSE;
+    return 1;
+
+  case SAVE_CLOSE:
+    saveFile.close();
+    saveStep = SAVE_IDLE;
+    return 0;
+
+  default:
+    return 0;
+}
+}
+
+/**
+ * @brief Tell if a save started by beginSaveUserAndGeneralSettings() is in progress, the file must
+ * not be read until its end
+ */
+bool isSavingUserAndGeneralSettings(void){
+return saveStep != SAVE_IDLE;
+}
+
+/**
+ * @brief Serialize the general setting and the users settings to a JSON string
+ * 
+ * @param machineConfig pointer to machineConfig structure
+ * @param userConfig pointer to users settings structure
+ * @param nbOfUserConfig number of users settings
+ * @param buffer destination of FILE_BUFFER_SIZE bytes
+ * @return int length of the string
+ */
+int serializeUserAndGeneralSettings(SLICERCONFIG *machineConfig, SETTINGS * userConfig, unsigned char nbOfUserConfig, char * buffer){
+
 // Allocate the JSON document
 //
 // Inside the brackets, 2048 is the capacity of the memory pool in bytes.
 // Don't forget to change this value to match your JSON document.
 // Use arduinojson.org/v6/assistant to compute the capacity.
 StaticJsonDocument<FILE_BUFFER_SIZE> JSONdoc;
-
-// Buffer for data string for JSON serializazion
-char buffer[FILE_BUFFER_SIZE];
+int length;
 
 // SERIALIZATION OF MACHINE SETTINGS
 JsonObject General = JSONdoc.createNestedObject("General");
@@ -260,12 +385,20 @@ General["BacklashCW_correction"] = machineConfig->BacklashCW;
 General["BacklashCCW_correction"] = machineConfig->BacklashCCW;
 General["HomingSpeed"] = machineConfig->HomingSpeed;
 General["MovingSpeed"] = machineConfig->MovingSpeed;
+General["PredictLead_ms"] = machineConfig->PredictLead_ms;
 
 // Add machine setting string data
 if(machineConfig->ScreenBacklight == 0)
   General["ScreenBacklight"] = "off";
   else General["ScreenBacklight"] = "on";
 
+if(machineConfig->DriveMode == DRIVE_MODE_HALF_STEP)
+  General["DriveMode"] = "half";
+  else General["DriveMode"] = "full";
+
+General["PotFilter"] = adcFilter_typeName(machineConfig->PotFilter);
+General["NtcFilter"] = adcFilter_typeName(machineConfig->NtcFilter);
+
 // NTC Settings
 General["NTC_Coeff"] = machineConfig->NTCsensor.RThbeta;
 General["NTC_RRef"] = machineConfig->NTCsensor.RRef;
@@ -304,16 +437,14 @@ for(i=0;i<nbOfUserConfig;i++){
 //serializeJson(JSONdoc, buffer);
 
 // Serialize to formatted output
-serializeJsonPretty(JSONdoc, buffer);
+length = serializeJsonPretty(JSONdoc, buffer, (size_t)FILE_BUFFER_SIZE);
 
 #ifdef SERIAL_DEBUG
 Serial.write("Serialisation result\n----------------\n");
 Serial.write(buffer);
 #endif
 
-if(SaveFileToSD(fileName, buffer) == 0)
-  return 0;
-else return -1;
+return length;
 }
 
 
@@ -15,6 +15,17 @@
 
 #define FILE_BUFFER_SIZE 2048
 
+// Stepper drive mode (SLICERCONFIG.DriveMode)
+#define DRIVE_MODE_FULL_STEP 0
+#define DRIVE_MODE_HALF_STEP 1
+
+// Thickness mode (SETTINGS.mode), MODE_TRIMMING is stored as 255 in the unsigned char
+#define MODE_NORMAL 0
+#define MODE_TRIMMING -1
+
+// Lead time of the blade crossing prediction when missing in the config [ms], 0 disables the prediction
+#define DEFAULT_PREDICT_LEAD_MS 5
+
 //#define SERIAL_DEBUG
 
 // Structure definition for application and data config
@@ -36,6 +47,10 @@ typedef struct SLICER_CONFIG {
     unsigned char HomingSpeed;
     unsigned char MovingSpeed;
     unsigned char ScreenBacklight;
+    unsigned char DriveMode;
+    unsigned int PredictLead_ms;
+    unsigned char PotFilter;
+    unsigned char NtcFilter;
     struct t_NTCsensor{
             int RThbeta=3435;  
             int RTh0=10000;
@@ -48,4 +63,7 @@ typedef struct SLICER_CONFIG {
 extern int getUserSettingsFromConfig(char * fileName, SETTINGS * userSetting, int configNb);
 extern int getGeneralSlicerConfig(char * fileName, SLICERCONFIG *machineConfig);
 extern int saveUserAndGeneralSettings(char * fileName, SLICERCONFIG * machineConfig, SETTINGS * userConfig,  unsigned char nbOfUserConfig);
+extern void beginSaveUserAndGeneralSettings(char * fileName, SLICERCONFIG * machineConfig, SETTINGS * userConfig,  unsigned char nbOfUserConfig);
+extern int continueSaveUserAndGeneralSettings(void);
+extern bool isSavingUserAndGeneralSettings(void);
 #endif
\ No newline at end of file
@@ -0,0 +1,97 @@
+/**
+ * @file knobDecoder.cpp
+ * @brief TC3 setup and interrupt: the levels of A and B are looked up in the transition table, the
+ *        valid transitions are summed and an event is queued when a detent is completed.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - TC3 sampling and transition table of the knob
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <Arduino.h>
+#include "knobDecoder.h"
+#include "inputEvents.h"
+
+// Count change for each transition, index = previous AB state << 2 | new AB state
+// 0 for no change and for the invalid transitions (both channels changed: bounce or missed sample)
+static const signed char quadratureTable[16] = {0,-1,1,0, 1,0,0,-1, -1,0,0,1, 0,1,-1,0};
+
+static unsigned char knobPinA;
+static unsigned char knobPinB;
+static unsigned char quadratureState;
+static signed char quadratureCount=0;
+
+/**
+ * @brief Start the decoding of the knob channels
+ *
+ * @param pinA knob channel A
+ * @param pinB knob channel B
+ */
+void knobDecoder_init(unsigned char pinA, unsigned char pinB){
+  knobPinA = pinA;
+  knobPinB = pinB;
+  quadratureState = (digitalRead(pinA) << 1) | digitalRead(pinB);
+  quadratureCount = 0;
+
+#ifdef ARDUINO_ARCH_SAMD
+  // TC3 clocked by GCLK0 (48MHz), overflow interrupt at the sampling rate
+  PM->APBCMASK.reg |= PM_APBCMASK_TC3;
+  GCLK->CLKCTRL.reg = GCLK_CLKCTRL_CLKEN | GCLK_CLKCTRL_GEN_GCLK0 | GCLK_CLKCTRL_ID_TCC2_TC3;
+  while(GCLK->STATUS.bit.SYNCBUSY);
+  TC3->COUNT16.CTRLA.reg = TC_CTRLA_SWRST;
+  while(TC3->COUNT16.CTRLA.bit.SWRST);
+  TC3->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 | TC_CTRLA_WAVEGEN_MFRQ | TC_CTRLA_PRESCALER_DIV64;
+  TC3->COUNT16.CC[0].reg = (SystemCoreClock / 64 / KNOB_SAMPLE_RATE_HZ) - 1;
+  while(TC3->COUNT16.STATUS.bit.SYNCBUSY);
+  TC3->COUNT16.INTENSET.reg = TC_INTENSET_OVF;
+  // same priority as the knob switch interrupt (EIC), the two event producers never preempt each other
+  NVIC_SetPriority(TC3_IRQn, 0);
+  NVIC_EnableIRQ(TC3_IRQn);
+  TC3->COUNT16.CTRLA.bit.ENABLE = 1;
+  while(TC3->COUNT16.STATUS.bit.SYNCBUSY);
+#else
+  attachInterrupt(digitalPinToInterrupt(pinA), knobDecoder_sample, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(pinB), knobDecoder_sample, CHANGE);
+#endif
+}
+
+/**
+ * @brief Read the knob channels and count the transition, queues a rotation event at each detent
+ *        (interrupt context)
+ */
+void knobDecoder_sample(void){
+  quadratureState = ((quadratureState << 2) | (digitalRead(knobPinA) << 1) | digitalRead(knobPinB)) & 0x0F;
+  quadratureCount += quadratureTable[quadratureState];
+  if(quadratureCount >= KNOB_COUNTS_PER_DETENT){
+    quadratureCount = 0;
+    inputEvents_push(EVENT_KNOB_ROTATION, 1, millis());
+  }else if(quadratureCount <= -KNOB_COUNTS_PER_DETENT){
+    quadratureCount = 0;
+    inputEvents_push(EVENT_KNOB_ROTATION, -1, millis());
+  }
+}
+
+/**
+ * @brief Value step of a detent for the numeric entry, larger when the knob turns fast
+ *
+ * @param interval_ms time since the previous detent in the same direction
+ * @return int value step
+ */
+int knobDecoder_step(unsigned long interval_ms){
+  if(interval_ms < KNOB_ACCEL_FAST_MS)
+    return KNOB_ACCEL_FAST_STEP;
+  if(interval_ms < KNOB_ACCEL_MEDIUM_MS)
+    return KNOB_ACCEL_MEDIUM_STEP;
+  if(interval_ms < KNOB_ACCEL_SLOW_MS)
+    return KNOB_ACCEL_SLOW_STEP;
+  return 1;
+}
+
+#ifdef ARDUINO_ARCH_SAMD
+void TC3_Handler(void){
+  TC3->COUNT16.INTFLAG.reg = TC_INTFLAG_OVF;
+  knobDecoder_sample();
+}
+#endif
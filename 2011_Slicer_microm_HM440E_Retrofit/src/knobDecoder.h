@@ -0,0 +1,35 @@
+/**
+ * @file knobDecoder.h
+ * @brief Full (4x) quadrature decoding of the rotary knob. Channels A and B are sampled at a fixed
+ *        rate by the TC3 interrupt (channel B has no external interrupt on the MKR Zero, its
+ *        EXTINT line is used by the knob switch). Invalid transitions (bounces) are ignored and one
+ *        rotation event is queued per detent, -1 when B leads A and +1 when A leads B.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - quadrature decoding of the knob sampled by TC3, replaces the edge interrupt
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef knobDecoder_h
+#define knobDecoder_h
+
+// Sampling rate of the knob channels [Hz]
+#define KNOB_SAMPLE_RATE_HZ 2000
+// Quadrature counts between two detents of the knob
+#define KNOB_COUNTS_PER_DETENT 4
+
+// Value step multiplier from the time between two detents (numeric entry)
+#define KNOB_ACCEL_FAST_MS 15
+#define KNOB_ACCEL_FAST_STEP 50
+#define KNOB_ACCEL_MEDIUM_MS 30
+#define KNOB_ACCEL_MEDIUM_STEP 10
+#define KNOB_ACCEL_SLOW_MS 60
+#define KNOB_ACCEL_SLOW_STEP 4
+
+extern void knobDecoder_init(unsigned char pinA, unsigned char pinB);
+extern void knobDecoder_sample(void);
+extern int knobDecoder_step(unsigned long interval_ms);
+
+#endif
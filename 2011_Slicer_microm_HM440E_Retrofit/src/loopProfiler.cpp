@@ -0,0 +1,130 @@
+/**
+ * @file loopProfiler.cpp
+ * @brief Execution times of the main loop and of the costly sections with a microsecond
+ *        resolution, read from micros() on the target and from the clock of the Arduino
+ *        stand-in on the host.
+ *        The probes are only recorded from the loop, never from an interrupt.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - statistics of the probes and serial report
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "loopProfiler.h"
+
+// Longest line of the serial report
+#define PROFILE_LINE_SIZE 64
+
+static PROFILE_PROBE probes[PROFILE_PROBES];
+static const char *const probeNames[PROFILE_PROBES] = {"loop", "home", "auto", "temp", "lcd", "motor"};
+
+/**
+ * @brief Current time [us], micros() of the core on the target. On the host the clock of the
+ *        stand-in is read without moving its virtual clock, micros() would count as a poll.
+ */
+unsigned long profiler_now_us(void){
+#ifdef ARDUINO_ARCH_SAMD
+  return micros();
+#else
+  return arduinoNative_micros();
+#endif
+}
+
+/**
+ * @brief Histogram bucket of a duration, number of significant bits
+ */
+unsigned char profiler_bucket(unsigned long duration_us){
+  unsigned char bucket = 0;
+
+  while(duration_us && bucket < PROFILE_BUCKETS - 1){
+    duration_us >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+/**
+ * @brief Add a duration to the statistics of a probe
+ *
+ * @param probe PROFILE_xxx
+ * @param duration_us measured duration
+ */
+void profiler_record(unsigned char probe, unsigned long duration_us){
+  PROFILE_PROBE *selected;
+
+  if(probe >= PROFILE_PROBES)
+    return;
+  selected = &probes[probe];
+  if(duration_us < selected->min_us)
+    selected->min_us = duration_us;
+  if(duration_us > selected->max_us)
+    selected->max_us = duration_us;
+  selected->total_us += duration_us;
+  selected->count++;
+  selected->histogram[profiler_bucket(duration_us)]++;
+}
+
+/**
+ * @brief Clear the statistics of all the probes, before the first measure
+ */
+void profiler_clear(void){
+  unsigned char i;
+
+  memset(probes, 0, sizeof(probes));
+  // any duration is lower
+  for(i=0;i<PROFILE_PROBES;i++)
+    probes[i].min_us = 0xFFFFFFFF;
+}
+
+const PROFILE_PROBE *profiler_probe(unsigned char probe){
+  if(probe >= PROFILE_PROBES)
+    return NULL;
+  return &probes[probe];
+}
+
+const char *profiler_name(unsigned char probe){
+  if(probe >= PROFILE_PROBES)
+    return "";
+  return probeNames[probe];
+}
+
+/**
+ * @brief Mean duration of a probe, 0 without measure
+ */
+unsigned long profiler_mean_us(unsigned char probe){
+  const PROFILE_PROBE *selected = profiler_probe(probe);
+
+  if(!selected || !selected->count)
+    return 0;
+  return selected->total_us / selected->count;
+}
+
+/**
+ * @brief Send the statistics of all the probes, one line per probe: name count min mean max,
+ *        then the counts of the histogram buckets (<1us, 1us, 2-3us, 4-7us ...)
+ *
+ * @param out serial port
+ */
+void profiler_print(Print *out){
+  char line[PROFILE_LINE_SIZE];
+  unsigned char i, bucket;
+
+  out->print("# loop profile [us]: probe count min mean max | histogram <1 1 2 4 .. ");
+  out->println(1UL << (PROFILE_BUCKETS - 2));
+  for(i=0;i<PROFILE_PROBES;i++){
+    const PROFILE_PROBE *selected = profiler_probe(i);
+
+    snprintf(line, PROFILE_LINE_SIZE, "%s %lu %lu %lu %lu |", probeNames[i], selected->count,
+             selected->count ? selected->min_us : 0, profiler_mean_us(i), selected->max_us);
+    out->print(line);
+    for(bucket=0;bucket<PROFILE_BUCKETS;bucket++){
+      out->print(' ');
+      out->print(selected->histogram[bucket]);
+    }
+    out->println();
+  }
+}
@@ -0,0 +1,56 @@
+/**
+ * @file loopProfiler.h
+ * @brief Execution times of the main loop and of the costly sections (home screen, automatic
+ *        mode, temperature, display redraws, motor commands) with a microsecond resolution.
+ *        The time is read from micros() on the target (the Cortex-M0+ has no cycle counter),
+ *        from the clock of the Arduino stand-in on the host. Each probe keeps the count, min,
+ *        max, mean and a log2 histogram of its durations, shown on a hidden page of the
+ *        diagnostics screen and sent over the serial port.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - loop and section execution times, shown on the diagnostics screen
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef loopProfiler_h
+#define loopProfiler_h
+
+#include <Arduino.h>
+
+// Sections measured
+#define PROFILE_LOOP 0              // Pass of loop(), idle passes included
+#define PROFILE_HOME 1              // Home(), values of the home screen
+#define PROFILE_MODE_AUTO 2         // ModeAuto(), cutting cycle
+#define PROFILE_TEMPERATURE 3       // GestionMesureTemp(), temperature measurement
+#define PROFILE_LCD 4               // Redraw of a whole screen (home, diagnostics, menu page)
+#define PROFILE_MOTOR 5             // Motor command of main.cpp written to the PCA9629A
+#define PROFILE_PROBES 6
+
+// Histogram buckets: bucket n counts the durations of n significant bits (2^(n-1)..2^n-1 us),
+// bucket 0 the durations under 1us, the last one every duration from 2^(PROFILE_BUCKETS-2)us
+#define PROFILE_BUCKETS 16
+
+// Measure of a section, both macros in the same block
+#define PROFILE_BEGIN(probe) unsigned long profileStart_##probe = profiler_now_us()
+#define PROFILE_END(probe) profiler_record(probe, profiler_now_us() - profileStart_##probe)
+
+typedef struct t_profileProbe{
+    unsigned long count;
+    unsigned long min_us;
+    unsigned long max_us;
+    unsigned long long total_us;    // Sum of the durations, mean = total_us / count
+    unsigned long histogram[PROFILE_BUCKETS];
+} PROFILE_PROBE;
+
+extern unsigned long profiler_now_us(void);
+extern void profiler_record(unsigned char probe, unsigned long duration_us);
+extern void profiler_clear(void);
+extern const PROFILE_PROBE *profiler_probe(unsigned char probe);
+extern const char *profiler_name(unsigned char probe);
+extern unsigned long profiler_mean_us(unsigned char probe);
+extern unsigned char profiler_bucket(unsigned long duration_us);
+extern void profiler_print(Print *out);
+
+#endif
@@ -20,16 +20,29 @@
 #include "jsonConfigSDcard.h"
 #include <SdFat.h>
 #include "mcp230xx.h"
+#include "taskScheduler.h"
+#include "adcSampler.h"
+#include "bladePredictor.h"
+#include "adcFilter.h"
+#include "sectioningStateMachine.h"
+#include "cycleTelemetry.h"
+#include "inputEvents.h"
+#include "knobDecoder.h"
+#include "ntcTable.h"
+#include "buzzerSequencer.h"
+#include "tempHistory.h"
+#include "i2cTrace.h"
+#include "loopProfiler.h"
 
 // Define the default motor speed and steps for run from BNC trigger
 #define DEFAULT_MOTOR_SPEED 80
 #define DEFAULT_MOTOR_STEPS 200
 #define DEFAULT_MOTOR_SPEED_REVERSE -80
 //config 
-#define NORMAL_MODE 0
-#define TRIMING_MODE 1
 #define ALARM_OFF 0
 #define ALARM_ON 1
+//longest time left until the temperature alarm displayed [min] 
+#define ALARM_MAX_MINUTES 999
 #define NB_OF_USER 1
 //DEFAULT
 #define DEFAULT_THICKNESS_NORMAL_MODE 100
@@ -40,6 +53,8 @@
 //Pinout 
 #define ADC_POT A2
 #define ADC_NTC A3
+#define ADC_NTC_HEAD A4
+#define ADC_KNIFE A5
 #define Buzzer A6
 #define MCP23017_INTB 0
 #define MCP23017_INTA 1
@@ -64,16 +79,12 @@
 #define LONG_PUSH_TIME 500
 #define BOUNCE_ELIM_TIME 10
 
-//POT
-#define AVERAGE_SIZE 5
-
-//Alarm
-#define Alarm_OFF 0
-#define Alarm_ON 1
-
-//mode 
-#define MODE_NORMAL 0
-#define MODE_TRIMMING -1
+//Jog
+#define JOG_IDLE 0
+#define JOG_UP 1
+#define JOG_DOWN 2
+#define JOG_FAULT 3
+#define JOG_STEPS 50
 
 //Menu index
 #define MENU_MODE 0
@@ -81,6 +92,31 @@
 #define MENU_THRESHOLD 2
 #define MENU_ALARM 3
 #define EXIT 1
+//Menu events, a menu function is called once per user interface pass 
+#define MENU_ENTER 0
+#define MENU_UPDATE 1
+#define MENU_RESUME 2
+//number of menus open at the same time 
+#define MENU_DEPTH 6
+//Menu item types 
+#define ITEM_PAGE 0
+#define ITEM_VALUE 1
+#define ITEM_CHOICE 2
+#define ITEM_POSITION 3
+#define ITEM_FUNCTION 4
+//Menu item value owner 
+#define VALUE_MACHINE 0
+#define VALUE_USER 1
+//Menu descriptors 
+#define MACHINE_VALUE(field) VALUE_MACHINE, offsetof(SLICERCONFIG, field), sizeof(((SLICERCONFIG *)0)->field)
+#define USER_VALUE(field) VALUE_USER, offsetof(SETTINGS, field), sizeof(((SETTINGS *)0)->field)
+#define MENU_PAGE_ITEM(label, page) {label, ITEM_PAGE, 0, 0, 0, 0, 0, 0, NULL, {NULL, NULL}, {0, 0}, page, NULL, NULL}
+#define MENU_VALUE(label, value, min, max, step, unit) {label, ITEM_VALUE, value, min, max, step, unit, {NULL, NULL}, {0, 0}, NULL, NULL, NULL}
+#define MENU_CHOICE(label, value, choice0, value0, choice1, value1, onSave) \
+  {label, ITEM_CHOICE, value, 0, 1, 1, NULL, {choice0, choice1}, {value0, value1}, NULL, NULL, onSave}
+#define MENU_POSITION(label, value) {label, ITEM_POSITION, value, 0, 0, 0, NULL, {NULL, NULL}, {0, 0}, NULL, NULL, NULL}
+#define MENU_FUNCTION(label, function) {label, ITEM_FUNCTION, 0, 0, 0, 0, 0, 0, NULL, {NULL, NULL}, {0, 0}, NULL, function, NULL}
+#define MENU_PAGE_OF(title, items, firstSelected, onClose) {title, items, sizeof(items)/sizeof(items[0]), firstSelected, onClose}
 
 //MCP23017
 #define FALLING_EDGE 1
@@ -89,13 +125,19 @@
 
 // LCD 
 #define MAX_ROW_INDEX_LCD 3
+//refresh period of the diagnostics screen [ms]
+#define DIAG_REFRESH_PERIOD 500
 #define FORCE 1
+//largest value shown in a field of the profile page 
+#define PROFILE_FIELD_MAX 999999UL
 
 //SLICER
 #define THICKNESS_MIN 1
 #define THICKNESS_MAX 500
 #define MODE_AUTO 1
 #define MODE_MAN 0
+//number of motor steps per feed unit in half step drive mode
+#define HALF_STEP_RATIO 2
 //mcp23017
 #define BTN_GRBTGL 0
 #define BTN_RETREN 1
@@ -113,6 +155,18 @@
 #define LED_MAN 15
 //alim
 #define VCC 3.3
+//hardware averaging (2^n conversions) and sampling time [half ADC clock] of the analog inputs,
+//each conversion must fit in its 250us slot of the 4 inputs frame (adcSampler.h)
+#define ADC_POT_OVERSAMPLING 4
+#define ADC_POT_SAMPLE_TIME 2
+#define ADC_NTC_OVERSAMPLING 3
+#define ADC_NTC_SAMPLE_TIME 16
+#define ADC_KNIFE_OVERSAMPLING 2
+#define ADC_KNIFE_SAMPLE_TIME 2
+//scheduler task periods [ms]
+#define CUTTING_TASK_PERIOD 5
+#define UI_TASK_PERIOD 50
+#define TEMP_TASK_PERIOD 1000
 // Boards declaration
 board_2004_01_V01 motor_2004_board; 
     
@@ -149,50 +203,78 @@ typedef struct t_NTCsensor{
       float Temp=-1;
   }measure;
 }NTCsensor;
+//menu function, for the menus which are not a list or a value 
+typedef void (*MenuFunction)(unsigned char menuEvent);
+//menu item, a line of a page 
+typedef struct t_menuItem{
+  const char *label;
+  unsigned char type;                 //ITEM_xxx
+  //value edited, in the machine config or the current user config 
+  unsigned char owner;                //VALUE_xxx
+  unsigned short offset;
+  unsigned char size;
+  int min;
+  int max;
+  int step;
+  const char *unit;
+  const char *choice[2];              //ITEM_CHOICE labels
+  int choiceValue[2];                 //ITEM_CHOICE values
+  const struct t_menuPage *child;     //ITEM_PAGE
+  MenuFunction function;              //ITEM_FUNCTION
+  void (*onSave)();                   //called when the value is stored 
+}MENU_ITEM;
+//menu page, a title and a list of items 
+typedef struct t_menuPage{
+  const char *title;
+  const MENU_ITEM *items;
+  unsigned char count;
+  unsigned char firstSelected;
+  void (*onClose)();                  //called when the page is closed 
+}MENU_PAGE;
+//open menu, a page or an item of the page 
+typedef struct t_menuLevel{
+  const MENU_PAGE *page;
+  const MENU_ITEM *item;              //NULL for the page list 
+  unsigned char selected;
+  unsigned char top;                  //first item displayed 
+}MENU_LEVEL;
 /*=======prototype function=====================*/
-
-void MenuAlarmState();
-void MenuAlarmSetting();
-void MenuAlarm();
-void MenuThresholdToCut();
-void MenuThreshold();
-void MenuThresholdToRewind();
-void MenuThreshold();
-void MenuThickness( );
-void MenuMode();
-void MenuBacklash();
-void MenuSelectConfig();
-void MenuUserConfig();
-void MenuSlicerConfig();
-void MenuThicknessNormal();
-void MenuThicknessTrimming();
-void MenuMotorSpeed();
-void MenuSelectUser();
-void ViewMenuUserConfig();
-void ScreenThreshold();
-void UserConfigScreenOne();
-void UserConfigScreenTwo();
-void backlashCwConfig();
-void backlashCcwConfig();
-void ArrowIndex(bool force);
+void MenuOpen(const MENU_PAGE *page);
+void MenuOpenItem(const MENU_ITEM *item);
+void MenuClose();
+bool MenuActive();
+void MenuRun();
+void ApplyDriveMode();
+void SaveSettings();
+void MenuSelectUser(unsigned char menuEvent);
 void Home();
-void knobRotationDetection();
 void knobSwitchDetection();
+void UpdateKnobInputs();
+void ClearKnobRotation();
 void RemoveZero( int value, unsigned char colonne, unsigned char ligne);
-void ThresholdDetection(SLICERCONFIG *machineConfig, SETTINGS *userSetting, unsigned int valPot);
-unsigned int AverageAdc (unsigned int valAdc);
-void SaveThreshold();
 void ShowPot(unsigned char columns, unsigned char raw);
 void PortInit();
 void lcdClear();
 void HomeScreen();
 void TestSD();
-void MotorHomingSpeed();
-void MotorMovingSpeed();
+unsigned int FeedToSteps(unsigned int feed);
+bool FeedMotorStopped();
+bool CycleMoveActive();
 void ModeAuto();
 void ModeManu();
-float calcNTCTemp(int UR10K, NTCsensor * NTC);
-void GestionMesureTemp(int refresh);
+void GestionMesureTemp();
+void GestionAlarmTemp();
+void ShowAlarmMinutes();
+void TaskCutting();
+void TaskUserInterface();
+void TaskTemperature();
+void DiagnosticsScreen();
+void Jog();
+void Diagnostics(bool force);
+void ProfilerScreen();
+void Profiler(bool force);
+void ShowProfileValue(unsigned long value, unsigned char column, unsigned char row);
+void SerialCommands();
 
 
 
@@ -200,15 +282,21 @@ void GestionMesureTemp(int refresh);
 
 String myString;
 bool lastState;
-int knobRotation;
+//knob rotations since the last pass, clockwise positive: detents, and detents weighted 
+//by the value step of the numeric entry 
+int knobDetents;
+int knobDelta;
 int gknobPsuh;
 unsigned int  gvalAdc;
+//pot value displayed in the menus, gvalAdc belongs to the cutting task 
+unsigned int gvalAdcMenu;
 unsigned int gvalAdcNtc;
+unsigned int gvalAdcNtcHead;
+//knife holder position, ADC value 
+unsigned int gvalAdcKnife;
+//minutes left until the temperature alarm, -1 without estimate 
+int galarmMinutes=-1;
 int currentUser;
-int arrowIndexRow=1;
-int arrowOldPosition=MAX_ROW_INDEX_LCD;
-bool gflagUpperMenu;
-bool gflagLowerMenu;
 int pas=10;
 int oldRotation;
 int gerr;
@@ -221,6 +309,17 @@ int gbtnjoyStpPressed;
 int gbtnjoyTrimPressed;
 int gbtnResetPressed;
 bool genRetractation=true;
+bool gdiagScreen=false;
+//hidden page of the diagnostics screen, loop profile 
+bool gprofileScreen=false;
+//probe shown on the profile page 
+unsigned char gprofileProbe=PROFILE_LOOP;
+//open menus, the last one receives the user inputs 
+MENU_LEVEL menuStack[MENU_DEPTH];
+int menuLevel=-1;
+//value of the item edited 
+int menuEditValue;
+bool gwaitBackRelease=false;
 int modeAutoMan=MODE_AUTO;
 int gtemperatur;
 int state;
@@ -228,16 +327,153 @@ byte retarrow[8] = {	0x10,0x10,0x14,0x16,0x1f,0x06,0x04};
 
 HOME home = {0,0,0};
 MENU menu;
+//chamber and specimen head temperatures 
 NTCsensor ntcSensor;
+NTCsensor ntcHeadSensor;
+//ADC code -> temperature of the NTC divider 
+NTC_TABLE ntcTable;
+//chamber temperature of the last hour, trend of the alarm 
+TEMP_HISTORY tempHistory;
+BLADEPREDICTOR bladePredictor;
+CYCLE_TELEMETRY cycleTelemetry;
+//filter of each ADC channel, chosen in the machine config
+AdcFilter potFilter;
+AdcFilter ntcFilter;
+AdcFilter ntcHeadFilter;
+//pot shown in the menus, separate from the cutting samples stream 
+AdcFilter potDisplayFilter;
+
+//menu tree, const so the descriptors stay in flash 
+const MENU_ITEM backlashItems[] = {
+  MENU_VALUE("Blacklash CW", MACHINE_VALUE(BacklashCW), 0, 9999, 1, NULL),
+  MENU_VALUE("Blacklash CCW", MACHINE_VALUE(BacklashCCW), 0, 9999, 1, NULL),
+};
+const MENU_PAGE backlashPage = MENU_PAGE_OF("---Backlash set.--", backlashItems, 0, NULL);
+
+const MENU_ITEM motorItems[] = {
+  MENU_VALUE("Homing speed", MACHINE_VALUE(HomingSpeed), 0, 100, 1, NULL),
+  MENU_VALUE("Moving speed", MACHINE_VALUE(MovingSpeed), 0, 100, 1, NULL),
+  MENU_CHOICE("Drive", MACHINE_VALUE(DriveMode), "Full step", DRIVE_MODE_FULL_STEP, "Half step", DRIVE_MODE_HALF_STEP, ApplyDriveMode),
+};
+const MENU_PAGE motorPage = MENU_PAGE_OF("---Motor setting--", motorItems, 0, NULL);
+
+const MENU_ITEM slicerItems[] = {
+  MENU_PAGE_ITEM("Blacklash correct.", &backlashPage),
+  MENU_PAGE_ITEM("Motor setting", &motorPage),
+};
+const MENU_PAGE slicerPage = MENU_PAGE_OF("---Slicer setting--", slicerItems, 0, NULL);
+
+const MENU_ITEM thicknessItems[] = {
+  MENU_VALUE("Normal", USER_VALUE(thicknessNormalMode), THICKNESS_MIN, THICKNESS_MAX, 1, "um"),
+  MENU_VALUE("Triming", USER_VALUE(thicknessTrimmingMode), THICKNESS_MIN, THICKNESS_MAX, 1, "um"),
+};
+const MENU_PAGE thicknessPage = MENU_PAGE_OF("-----Thickness-----", thicknessItems, 0, NULL);
+
+const MENU_ITEM thresholdItems[] = {
+  MENU_POSITION("To cut", USER_VALUE(thresholdToCut)),
+  MENU_POSITION("To rewind", USER_VALUE(thresholdToRewind)),
+};
+const MENU_PAGE thresholdPage = MENU_PAGE_OF("-----Threshold-----", thresholdItems, 0, NULL);
+
+const MENU_ITEM alarmItems[] = {
+  MENU_CHOICE("State", USER_VALUE(alarmState), "OFF", ALARM_OFF, "ON", ALARM_ON, NULL),
+  MENU_VALUE("Temp.", USER_VALUE(tempAlarmDegree), -99, 999, 1, "C"),
+};
+const MENU_PAGE alarmPage = MENU_PAGE_OF("-------Alarm--------", alarmItems, 0, NULL);
+
+const MENU_ITEM userItems[] = {
+  MENU_CHOICE("Mode", USER_VALUE(mode), "Normal", MODE_NORMAL, "Trimming", MODE_TRIMMING, NULL),
+  MENU_PAGE_ITEM("Thickness", &thicknessPage),
+  MENU_PAGE_ITEM("Thresholds", &thresholdPage),
+  MENU_PAGE_ITEM("Alarm", &alarmPage),
+};
+const MENU_PAGE userPage = MENU_PAGE_OF("----user setting---", userItems, 0, NULL);
+
+const MENU_ITEM selectConfigItems[] = {
+  MENU_FUNCTION("User select", MenuSelectUser),
+  MENU_PAGE_ITEM("Current user set.", &userPage),
+  MENU_PAGE_ITEM("Slicer setting", &slicerPage),
+};
+//the configuration is saved when the setting menu is closed 
+const MENU_PAGE selectConfigPage = MENU_PAGE_OF("---Select setting--", selectConfigItems, 1, SaveSettings);
+
+/**
+ * @brief hardware of the cutting cycle, limit switch and led on the MCP23017, feed motor on the PCA9629A 
+ */
+class SlicerSectioningIO : public SectioningInputs, public SectioningActuators
+{
+  public:
+    bool canRetract()
+    {
+      gSwCalibPressed = mcp230xx_getChannel(&mcp23017config,SW_CALIBRATION);
+      return gSwCalibPressed;
+    }
+    int feedMotorState()
+    {
+      return motor_2004_board.getPredictedStepperState(MOTOR_A);
+    }
+    int feedQueuedMoves()
+    {
+      return motor_2004_board.getQueuedRotationCount(MOTOR_A);
+    }
+    unsigned long timeMs()
+    {
+      return millis();
+    }
+    void feedMove(int speed, unsigned int feed)
+    {
+      PROFILE_BEGIN(PROFILE_MOTOR);
+      motor_2004_board.stepperRotation(MOTOR_A, speed, FeedToSteps(feed));
+      PROFILE_END(PROFILE_MOTOR);
+    }
+    void queueFeedMove(int speed, unsigned int feed)
+    {
+      PROFILE_BEGIN(PROFILE_MOTOR);
+      motor_2004_board.queueStepperRotation(MOTOR_A, speed, FeedToSteps(feed));
+      PROFILE_END(PROFILE_MOTOR);
+    }
+    void setCutLed(bool on)
+    {
+      //led active low
+      mcp230xx_setChannel(&mcp23017config,LED_RETRA,!on);
+    }
+    void countSection()
+    {
+      home.counterValue++;
+      //the I2C transfers are compared cycle by cycle 
+      I2C_TRACE_CYCLE_MARK();
+    }
+    void feedFault()
+    {
+      motor_2004_board.flushStepperQueue(MOTOR_A);
+      buzzer_play(BUZZER_FAULT);
+    }
+};
+SlicerSectioningIO sectioningIO;
+SectioningStateMachine sectioning(&sectioningIO, &sectioningIO, &bladePredictor, &cycleTelemetry);
+
+//scheduler task table {name, function, period [ms], priority}
+TASK taskTable[] = {
+  TASK_ENTRY("Cutting", TaskCutting, CUTTING_TASK_PERIOD, 0),
+  TASK_ENTRY("UI", TaskUserInterface, UI_TASK_PERIOD, 1),
+  TASK_ENTRY("Temp", TaskTemperature, TEMP_TASK_PERIOD, 2),
+};
+#define NB_OF_TASK (sizeof(taskTable)/sizeof(taskTable[0]))
 
 // Arduino setup
 
 void setup() {
   // init. port Arduino
   PortInit();
+  //execution times measured from the first motor command 
+  profiler_clear();
+  //loop profile and I2C trace on request 
+  Serial.begin(115200);
    
   //Interupt setting 
-  attachInterrupt(digitalPinToInterrupt(KNOB_CHANNEL_A),knobRotationDetection, FALLING);
+  knobDecoder_init(KNOB_CHANNEL_A, KNOB_CHANNEL_B);
+  //buzzer patterns played by the timer 
+  buzzer_init(Buzzer);
   attachInterrupt(digitalPinToInterrupt(KNOB_SWITCH_A),knobSwitchDetection, FALLING);
   //init. LCD
   lcd.begin(20,4);
@@ -249,12 +485,31 @@ void setup() {
   motor_2004_board.begin();
   //Get the General Slicer Config object
   getGeneralSlicerConfig("config.cfg", &machineConfig);
+  //full or half step drive from the machine config
+  motor_2004_board.setStepperDriveMode(MOTOR_A, machineConfig.DriveMode);
+  //threshold crossings predicted with the lead time of the machine config
+  predictor_init(&bladePredictor, machineConfig.PredictLead_ms);
+  telemetry_init(&cycleTelemetry);
+  tempHistory_init(&tempHistory);
+  potFilter.setType(machineConfig.PotFilter);
+  ntcFilter.setType(machineConfig.NtcFilter);
+  ntcHeadFilter.setType(machineConfig.NtcFilter);
+  //temperature table of the NTC divider, the measure is an integer interpolation 
+  ntcTable_build(&ntcTable, ntcSensor.settings.RThbeta, ntcSensor.settings.RTh0, ntcSensor.settings.Th0, ntcSensor.settings.RRef);
+  //inputs scanned with the blade position, the NTC dividers need a longer sampling 
+  adcSampler_setChannel(ADC_POT, ADC_POT_OVERSAMPLING, ADC_POT_SAMPLE_TIME);
+  adcSampler_setChannel(ADC_NTC, ADC_NTC_OVERSAMPLING, ADC_NTC_SAMPLE_TIME);
+  adcSampler_setChannel(ADC_NTC_HEAD, ADC_NTC_OVERSAMPLING, ADC_NTC_SAMPLE_TIME);
+  adcSampler_setChannel(ADC_KNIFE, ADC_KNIFE_OVERSAMPLING, ADC_KNIFE_SAMPLE_TIME);
+  potDisplayFilter.setType(machineConfig.PotFilter);
   //Reset MCP23017
   digitalWrite(2,LOW);
   digitalWrite(2,HIGH);
   //MCP23017 config 
   gerr+=mcp23017_init(&mcp23017config);
   gerr+=mcp23017_setPort(&mcp23017config,0xFF);
+  if(gerr)
+    buzzer_play(BUZZER_FAULT);
   //display fixed text
   lcd.setCursor(0,0);
   lcd.print("    please wait    ");
@@ -265,81 +520,141 @@ void setup() {
   //waits for the user to press the knob button until the limit sensor is active 
   do
   {
+    UpdateKnobInputs();
     gSwCalibPressed = mcp230xx_getChannel(&mcp23017config,SW_CALIBRATION);
     motor_2004_board.stepperRotation(MOTOR_A,-(machineConfig.HomingSpeed),50);
   }while(gSwCalibPressed && gknobPsuh == NO_PUSH );
    gknobPsuh = NO_PUSH;
+  //the knob turned during the homing does not select a user 
+  ClearKnobRotation();
   lcdClear();
-  //select User Menu 
-  MenuSelectUser();
-  //fixed text display home screen 
-  HomeScreen();
- 
- 
+  //select User Menu, first item of the setting menu, the home screen is displayed when it is closed 
+  MenuOpenItem(&selectConfigItems[0]);
+  while(MenuActive())
+  {
+    UpdateKnobInputs();
+    MenuRun();
+  }
+  //blade position sampled at a fixed rate by the timer and the DMA 
+  adcSampler_init(ADC_POT);
+  //releases all the tasks 
+  scheduler_init(taskTable, NB_OF_TASK);
 }
 
 void loop() {
+  PROFILE_BEGIN(PROFILE_LOOP);
+  //runs the due task with the highest priority 
+  scheduler_run(taskTable, NB_OF_TASK);
+  PROFILE_END(PROFILE_LOOP);
+}
+/**
+ * @brief cutting task, automatic or manual mode at a fixed rate  
+ * 
+ */
+void TaskCutting()
+{
+  // read automatic/manual button 
+  gbtnAutoManPressed= mcp230xx_getChannel(&mcp23017config,BTN_AUTMAN);
+  //choose mode 
+  if(!gbtnAutoManPressed && lastState != gbtnAutoManPressed)
+  {
+    modeAutoMan = !modeAutoMan;
+    //a cycle stopped by a motor timeout restarts when the automatic mode is selected again 
+    if(modeAutoMan == MODE_AUTO && sectioning.getStep() == SECTION_FAULT)
+      sectioning.reset();
+  }
+  lastState=gbtnAutoManPressed;
+  if(modeAutoMan == MODE_AUTO)
+  {
+    PROFILE_BEGIN(PROFILE_MODE_AUTO);
+    ModeAuto();
+    PROFILE_END(PROFILE_MODE_AUTO);
+  }
+  else 
+  {
+    //the samples are not used but read, the last results of the scanned inputs stay current 
+    while(adcSampler_read(&gvalAdc));
+    ModeManu();
+  }
+}
+/**
+ * @brief temperature task, measures the temperature once a period 
+ * 
+ */
+void TaskTemperature()
+{
+  PROFILE_BEGIN(PROFILE_TEMPERATURE);
+  GestionMesureTemp();
+  PROFILE_END(PROFILE_TEMPERATURE);
+  GestionAlarmTemp();
+}
+/**
+ * @brief user interface task, home screen, buttons, joystick, knob and menus 
+ * 
+ */
+void TaskUserInterface()
+{
+  //knob events since the last pass 
+  UpdateKnobInputs();
+  //loop profile or I2C trace requested over the serial port 
+  SerialCommands();
+  //settings saved one step per pass, the cutting task runs in between 
+  continueSaveUserAndGeneralSettings();
+  //the open menu gets the inputs, the cutting task keeps running 
+  if(MenuActive())
+  {
+    MenuRun();
+    return;
+  }
+  //hidden page of the diagnostics screen, the loop profile 
+  if (gknobPsuh == LONG_PUSH && gdiagScreen && !gprofileScreen)
+  {
+    gknobPsuh = NO_PUSH;
+    gprofileScreen = true;
+    ProfilerScreen();
+  }
   //allows you to enter the configuration menus
-  if (gknobPsuh == LONG_PUSH)
+  else if (gknobPsuh == LONG_PUSH)
   {
     gknobPsuh = NO_PUSH;
-    //select config Menu  
-    MenuSelectConfig();
-    //fixed text display home screen 
-    HomeScreen();
-    //Saves the configuration to the MicroSD card
-    saveUserAndGeneralSettings("config.cfg", &machineConfig, userConfig, MAX_USER_SETTINGS);    
+    //select config Menu, saved and back to the home screen when it is closed 
+    MenuOpen(&selectConfigPage);
+    gdiagScreen = false;
+    gprofileScreen = false;
   }
-  else
+  else if (gknobPsuh == PUSH && gprofileScreen)
   {
-    //changes the values in the home screen
-    Home();
-    // read automatic/manual button 
-    gbtnAutoManPressed= mcp230xx_getChannel(&mcp23017config,BTN_AUTMAN);
-    //choose mode 
-    if(!gbtnAutoManPressed && lastState != gbtnAutoManPressed)
-    modeAutoMan = !modeAutoMan;
-    lastState=gbtnAutoManPressed;
-    if(modeAutoMan == MODE_AUTO)
-    {
-      ModeAuto();
-    }
+    gknobPsuh = NO_PUSH;
+    //back to the diagnostics screen 
+    gprofileScreen = false;
+    DiagnosticsScreen();
+  }
+  else if (gknobPsuh == PUSH)
+  {
+    gknobPsuh = NO_PUSH;
+    //switches between the home screen and the diagnostics screen 
+    gdiagScreen = !gdiagScreen;
+    if(gdiagScreen)
+      DiagnosticsScreen();
     else 
+      HomeScreen();
+  }
+  else
+  {
+    //changes the values in the home, diagnostics or profile screen, 
+    //the knob selects the probe on the profile page instead of moving the motor 
+    if(gprofileScreen)
+      Profiler(false);
+    else if(gdiagScreen)
+      Diagnostics(false);
+    else
     {
-      ModeManu();
-    }
-    //read continous up button
-    gbtnjoygrbupPressed = mcp230xx_getChannel(&mcp23017config,JOY_GRBUP);
-    if(gbtnjoygrbupPressed )
-    {
-      //continous up 
-      do
-      {
-        //wait motor end move  
-        if(motor_2004_board.getStepperState(MOTOR_A)==0)
-        motor_2004_board.stepperRotation(MOTOR_A,machineConfig.HomingSpeed,50);
-        gbtnjoygrbupPressed = mcp230xx_getChannel(&mcp23017config,JOY_GRBUP);
-       state = motor_2004_board.getStepperState(MOTOR_A);
-      
-      }while (gbtnjoygrbupPressed );
-    }
-    //read continous down button 
-    gbtnjoygrdwnPressed = mcp230xx_getChannel(&mcp23017config,JOY_GRBDWN);
-    //read switch calibration 
-    gSwCalibPressed = mcp230xx_getChannel(&mcp23017config,SW_CALIBRATION);
-
-    if(gbtnjoygrdwnPressed && gSwCalibPressed)
-    {
-      //continous down 
-      do
-      {
-        gbtnjoygrdwnPressed = mcp230xx_getChannel(&mcp23017config,JOY_GRBDWN);
-        gSwCalibPressed = mcp230xx_getChannel(&mcp23017config,SW_CALIBRATION);
-        //wait motor move
-        if(motor_2004_board.getStepperState(MOTOR_A)==0)
-          motor_2004_board.stepperRotation(MOTOR_A,-(machineConfig.HomingSpeed),50);
-      }while(gbtnjoygrdwnPressed && gSwCalibPressed);
+      PROFILE_BEGIN(PROFILE_HOME);
+      Home();
+      PROFILE_END(PROFILE_HOME);
     }
+    //continous up and down with the joystick 
+    Jog();
     //read step button 
     gbtnjoyStpPressed = mcp230xx_getChannel(&mcp23017config,JOY_STP);
     //change mode 
@@ -350,120 +665,144 @@ void loop() {
     //change mode 
     if(gbtnjoyTrimPressed)
       userConfig[currentUser].mode = MODE_TRIMMING; 
-    //temperature measurement management 
-    GestionMesureTemp(1000);
     // reset counter value 
     gbtnResetPressed = mcp230xx_getChannel(&mcp23017config,BTN_RES);
     if(!gbtnResetPressed)
     {
       home.counterValue = 0;
     }
-    //move motor whit knob 
-    if(knobRotation == CW)
-      motor_2004_board.stepperRotation(MOTOR_A,machineConfig.MovingSpeed,userConfig[currentUser].thicknessNormalMode);
-    if(knobRotation == CCW && gSwCalibPressed)
+    //move motor whit knob, one thickness per detent, not over a move of the automatic cycle 
+    if(knobDetents > 0 && !CycleMoveActive())
+    {
+      PROFILE_BEGIN(PROFILE_MOTOR);
+      motor_2004_board.stepperRotation(MOTOR_A,machineConfig.MovingSpeed,knobDetents*FeedToSteps(userConfig[currentUser].thicknessNormalMode));
+      PROFILE_END(PROFILE_MOTOR);
+    }
+    if(knobDetents < 0 && gSwCalibPressed && !CycleMoveActive() && FeedMotorStopped())
     {
-      if(motor_2004_board.getStepperState(MOTOR_A)==0)
-        motor_2004_board.stepperRotation(MOTOR_A,-(machineConfig.MovingSpeed),userConfig[currentUser].thicknessNormalMode);
+      PROFILE_BEGIN(PROFILE_MOTOR);
+      motor_2004_board.stepperRotation(MOTOR_A,-(machineConfig.MovingSpeed),-knobDetents*FeedToSteps(userConfig[currentUser].thicknessNormalMode));
+      PROFILE_END(PROFILE_MOTOR);
     }
-    if(knobRotation != NO_ROTATION)
-      knobRotation = NO_ROTATION;  
+    ClearKnobRotation();
   }
 }
 /**
- * @brief  temperature measurement 
- * @param refresh interval between measurements [ms]
+ * @brief continous up and down moves while the joystick is held, 
+ *        one move is started per pass when the previous one is finished 
  */
-void GestionMesureTemp(int refresh)
-{ 
-  unsigned int timer;
-  static unsigned int oldTimer=0;
-  static unsigned int oldTimerBuzzer=0;
-  static unsigned int counterBip=0;
-  static unsigned char flagTresholdTemp=0;
-  timer=millis();
-  //measures the temperature 
-  if((timer-oldTimer)>=refresh)
+void Jog()
+{
+  static int jogState=JOG_IDLE;
+  int motorState;
+  //read continous up and down buttons
+  gbtnjoygrbupPressed = mcp230xx_getChannel(&mcp23017config,JOY_GRBUP);
+  gbtnjoygrdwnPressed = mcp230xx_getChannel(&mcp23017config,JOY_GRBDWN);
+  //read switch calibration 
+  gSwCalibPressed = mcp230xx_getChannel(&mcp23017config,SW_CALIBRATION);
+  switch(jogState)
   {
-    oldTimer=timer;
-    gvalAdcNtc = analogRead(ADC_NTC);
-    gvalAdcNtc = ((3300* gvalAdcNtc)/1023);
-    ntcSensor.measure.Temp = calcNTCTemp(gvalAdcNtc, &ntcSensor);
-    ntcSensor.measure.Temp *=100;
-    ntcSensor.measure.Temp = (int)ntcSensor.measure.Temp /10;
-    ntcSensor.measure.Temp /=10;
+    case JOG_IDLE:
+      if(gbtnjoygrbupPressed)
+        jogState = JOG_UP;
+      else if(gbtnjoygrdwnPressed && gSwCalibPressed)
+        jogState = JOG_DOWN;
+      break;
+    case JOG_UP:
+      if(!gbtnjoygrbupPressed)
+        jogState = JOG_IDLE;
+      break;
+    case JOG_DOWN:
+      //stops at the limit switch 
+      if(!gSwCalibPressed)
+        buzzer_play(BUZZER_LIMIT);
+      if(!gbtnjoygrdwnPressed || !gSwCalibPressed)
+        jogState = JOG_IDLE;
+      break;
+    case JOG_FAULT:
+      //after a motor timeout, the joystick must be released 
+      if(!gbtnjoygrbupPressed && !gbtnjoygrdwnPressed)
+        jogState = JOG_IDLE;
+      return;
+    default:
+      jogState = JOG_IDLE;
+      break;
   }
-  //temperature threshold reached 
-  if(flagTresholdTemp)
+  //wait motor end move, the jog stops on a motor timeout  
+  if(jogState == JOG_IDLE)
+    return;
+  //the automatic cycle keeps its running and queued moves 
+  if(CycleMoveActive())
+    return;
+  motorState = motor_2004_board.getPredictedStepperState(MOTOR_A);
+  if(motorState == STEPPER_TIMEOUT)
   {
-    //activates the buzzer 
-    if(userConfig[currentUser].tempAlarmDegree<0)
-    {
-      if(ntcSensor.measure.Temp>=userConfig[currentUser].tempAlarmDegree)
-      {
-        //switches on the buzzer one second three times every second  
-        if(counterBip<3)
-        {
-          if((timer-oldTimerBuzzer)>=1000)
-          { 
-            oldTimerBuzzer=timer;
-            digitalWrite(Buzzer,HIGH);
-          }
-          else 
-          digitalWrite(Buzzer,LOW);
-        }
-        counterBip++;
-        if(counterBip>=3)
-          counterBip=4;       
-      }
-      else
-      {
-        counterBip=0;
-        flagTresholdTemp=0;
-      }   
-    }
-    if(userConfig[currentUser].tempAlarmDegree>0)
-    {
-      //activates the buzzer 
-      if(ntcSensor.measure.Temp<=userConfig[currentUser].tempAlarmDegree)
-      {
-        //switches on the buzzer one second three times every second  
-        if(counterBip<3)
-        {
-          if((timer-oldTimerBuzzer)>=1000)
-          { 
-            oldTimerBuzzer=timer;
-            digitalWrite(Buzzer,HIGH);
-          }
-          else 
-          digitalWrite(Buzzer,LOW);
-        }
-        counterBip++;
-        if(counterBip>=3)
-          counterBip=4;
-      }
-      else
-      {
-        counterBip=0;
-        flagTresholdTemp=0;
-      }     
-    }
+    motor_2004_board.flushStepperQueue(MOTOR_A);
+    buzzer_play(BUZZER_FAULT);
+    jogState = JOG_FAULT;
+  }
+  else if(motorState == STEPPER_STOPPED)
+  {
+    PROFILE_BEGIN(PROFILE_MOTOR);
+    if(jogState == JOG_UP)
+      motor_2004_board.stepperRotation(MOTOR_A,machineConfig.HomingSpeed,JOG_STEPS);
+    else
+      motor_2004_board.stepperRotation(MOTOR_A,-(machineConfig.HomingSpeed),JOG_STEPS);
+    PROFILE_END(PROFILE_MOTOR);
+  }
+}
+/**
+ * @brief  temperature measurement, the interval between measurements 
+ *         is given by the temperature task period 
+ */
+void GestionMesureTemp()
+{ 
+  int centiDegrees;
+
+  //measures the temperatures, last results of the ADC scan 
+  gvalAdcNtc = ntcFilter.apply(adcSampler_value(ADC_NTC));
+  gvalAdcNtcHead = ntcHeadFilter.apply(adcSampler_value(ADC_NTC_HEAD));
+  centiDegrees = ntcTable_centiDegrees(&ntcTable, gvalAdcNtc, ADC_SAMPLER_RESULT_BITS);
+  tempHistory_add(&tempHistory, centiDegrees);
+  //truncated to 0.1 degree for the display and the alarm 
+  ntcSensor.measure.Temp = (centiDegrees / 10) / 10.0;
+  ntcHeadSensor.measure.Temp = (ntcTable_centiDegrees(&ntcTable, gvalAdcNtcHead, ADC_SAMPLER_RESULT_BITS) / 10) / 10.0;
+  gvalAdcKnife = adcSampler_value(ADC_KNIFE);
+}
+/**
+ * @brief  temperature alarm, beeps when the temperature threshold is reached 
+ */
+void GestionAlarmTemp()
+{ 
+  //armed while the temperature is beyond the threshold, away from zero 
+  static bool alarmArmed=false;
+  int threshold=userConfig[currentUser].tempAlarmDegree;
+  bool beyondThreshold;
+  long timeLeft;
+
+  if(threshold<0)
+    beyondThreshold = ntcSensor.measure.Temp<threshold;
+  else if(threshold>0)
+    beyondThreshold = ntcSensor.measure.Temp>threshold;
+  else 
+  {
+    galarmMinutes=-1;
+    return;
   }
+  //time left until the threshold with the trend of the temperature history 
+  timeLeft = beyondThreshold ? tempHistory_timeToReach_s(&tempHistory, threshold*100) : -1;
+  if(timeLeft<0 || timeLeft>ALARM_MAX_MINUTES*60L)
+    galarmMinutes=-1;
   else 
+    galarmMinutes=(timeLeft+59)/60;
+  if(beyondThreshold)
+    alarmArmed=true;
+  else if(alarmArmed)
   {
-    if(userConfig[currentUser].tempAlarmDegree<0)
-    {
-      //temperature threshold reached 
-      if(ntcSensor.measure.Temp<=userConfig[currentUser].tempAlarmDegree)
-        flagTresholdTemp=1;
-    }
-    if(userConfig[currentUser].tempAlarmDegree>0)
-    {
-      //temperature threshold reached 
-      if(ntcSensor.measure.Temp>=userConfig[currentUser].tempAlarmDegree)
-        flagTresholdTemp=1; 
-    }
-  }   
+    //temperature threshold reached, the pattern is played by the buzzer timer 
+    alarmArmed=false;
+    buzzer_play(BUZZER_ALARM);
+  }
 }
 /**
  * @brief Mode manual 
@@ -480,16 +819,21 @@ void ModeManu()
   mcp230xx_setChannel(&mcp23017config,LED_MAN,0);
   //defined the cutting thickness 
   btnPressed=mcp230xx_getChannel(&mcp23017config,BTN_GRBTGL);
-  if(userConfig[currentUser].mode == NORMAL_MODE)
+  if(userConfig[currentUser].mode == MODE_NORMAL)
     thickness = userConfig[currentUser].thicknessNormalMode;
   else 
     thickness = userConfig[currentUser].thicknessTrimmingMode;
   //move up specimen   
   if(!btnPressed && odlState!=btnPressed)
   {
-    if(motor_2004_board.getStepperState(MOTOR_A)==0)
-      motor_2004_board.stepperRotation(MOTOR_A, speed, thickness);
+    if(FeedMotorStopped())
+    {
+      PROFILE_BEGIN(PROFILE_MOTOR);
+      motor_2004_board.stepperRotation(MOTOR_A, speed, FeedToSteps(thickness));
+      PROFILE_END(PROFILE_MOTOR);
+    }
     home.counterValue++;
+    I2C_TRACE_CYCLE_MARK();
   }
   odlState=btnPressed;
 }
@@ -514,577 +858,404 @@ void ModeAuto()
     genRetractation = !genRetractation;
   } 
   odlState=btnPressed;
-  //determines the blade position
-  gvalAdc = analogRead(ADC_POT);
-  //detects thresholds 
-  ThresholdDetection(&machineConfig, &userConfig[currentUser], gvalAdc);
+  //detects thresholds on each blade position sampled since the last pass 
+  while(adcSampler_read(&gvalAdc))
+  {
+    gvalAdc = potFilter.apply(gvalAdc);
+    sectioning.process(&machineConfig, &userConfig[currentUser], genRetractation, gvalAdc);
+  }
 }
 /**
- * @brief Raises or lowers the platform depending on the position of the blade
- * @param machineConfig 
- * @param userSetting 
- * @param valPot 
+ * @brief address of the value of a menu item, in the machine config or in the current user config 
+ * 
+ * @param item menu item 
+ * @return unsigned char* address of the value 
  */
-void ThresholdDetection(SLICERCONFIG *machineConfig, SETTINGS *userSetting, unsigned int valPot)
+unsigned char *MenuValueAddress(const MENU_ITEM *item)
 {
-  static unsigned char step=4;
-  static int speed = machineConfig->MovingSpeed;
-  static unsigned int thresholdToCut = userSetting->thresholdToCut;
-  static unsigned int thresholdToRewind = userSetting->thresholdToRewind;
-  unsigned int backlash = machineConfig->BacklashCW;
-  unsigned int thickness;
-
-  if(userSetting->mode == NORMAL_MODE)
-    thickness = userSetting->thicknessNormalMode;
-  else 
-    thickness = userSetting->thicknessTrimmingMode;
-  if(thresholdToCut != userSetting->thresholdToCut)
-  {
-    thresholdToCut = userSetting->thresholdToCut;
-    step=4;
-  }
-  if(thresholdToRewind != userSetting->thresholdToRewind)
-  {
-    thresholdToRewind = userSetting->thresholdToRewind;
-    step=4;
-  }    
-  switch (step)
-  {
-    /*
-    case 0:// première passe
-      if(valPot <= thresholdToCut)
-        step=1;
-      break;*/
-    case 1://Attendre d'arriver au trheshold to rewind 
-     
-      if(valPot >= thresholdToRewind)
-      {       
-          if(!genRetractation)
-            step=3;
-          else 
-            step=2;
-        home.counterValue++;
-      }
-      
-      break;
-    case 2://Descendre plateau
-       gSwCalibPressed = mcp230xx_getChannel(&mcp23017config,SW_CALIBRATION);
-       if(gSwCalibPressed)
-       {
-         
-          if(speed>0)
-          {
-            backlash = machineConfig->BacklashCCW;
-            speed = (-1)*speed;
-          }
-          else 
-          {
-            backlash=0;
-          }
-          motor_2004_board.stepperRotation(MOTOR_A, speed, thickness+backlash);         
-       }
-        step=3;
-      break;
-    case 3://Allumer led retra 
-         if(motor_2004_board.getStepperState(MOTOR_A)==0)//motor stopped
-         {
-            //mcp230xx_setChannel(&mcp23017config,LED_RETRA,0);  
-            step=4;
-         }
-      break;
-    case 4://Attendre d'atteindre le threshold to cut  
-       mcp230xx_setChannel(&mcp23017config,LED_RETRA,0);  
-      if(valPot <= thresholdToCut)
-      {     
-          step=5;
-      }
-      break;
-    case 5://éteindre led 
-       mcp230xx_setChannel(&mcp23017config,LED_RETRA,1);
-       step=6;
-      break;
-    case 6:// Monter plateau 
-       
-          if(speed<0)
-          {
-            speed = (-1)*speed;
-            backlash = machineConfig->BacklashCW;
-          }
-          else 
-          {
-            backlash=0;
-          }
-          if(!genRetractation)
-          {
-            speed=machineConfig->MovingSpeed;
-            home.counterValue++;
-          }
-          else
-          {        
-            thickness+=thickness;
-          }
-          motor_2004_board.stepperRotation(MOTOR_A, speed, thickness+backlash);
-          step=7;
-      break;
-      case 7:
-       if(motor_2004_board.getStepperState(MOTOR_A)==0)//motor stopped
-        {  
-          step=1;
-        }
-      break;
-    default:
-      
-      break;
-  }
-
+  if(item->owner == VALUE_USER)
+    return (unsigned char *)&userConfig[currentUser] + item->offset;
+  return (unsigned char *)&machineConfig + item->offset;
 }
 /**
- * @brief Setup selection menu
- * allows us to choose the configuration we want to modify between slicer, current user and change user 
+ * @brief reads the value of a menu item 
+ * 
+ * @param item menu item 
+ * @return int value 
  */
-void MenuSelectConfig()
+int MenuGetValue(const MENU_ITEM *item)
 {
- static bool firstLoop=false;
-  do
-    {
-      if(!firstLoop)
-      {
-        firstLoop = true;
-        lcdClear();
-        lcd.setCursor(1,0);
-        lcd.print("---Select setting--");
-        lcd.setCursor(1,1);
-        lcd.print("User select");
-        lcd.setCursor(1,2);
-        lcd.print("Current user set.");
-        lcd.setCursor(1,3);
-        lcd.print("Slicer setting");
-        arrowIndexRow =2;
-        ArrowIndex(FORCE);
-      }
+  unsigned char *value = MenuValueAddress(item);
 
-      ArrowIndex(0);
-      
-      if(gknobPsuh == PUSH)
-      {
-        firstLoop=false;
-        gknobPsuh = NO_PUSH;
-        switch (arrowIndexRow)
-        {
-          case 1:
-          MenuSelectUser();
-          break;
-          case 2: 
-          MenuUserConfig();
-          break;
-          case 3:
-          MenuSlicerConfig();
-          break;
-          default :
-          break;
-        }
-      }
-      gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-    }while(gknobPsuh != LONG_PUSH && gbtnBackPressed == 1);
-    do
-      gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-    while (!gbtnBackPressed);
-    gknobPsuh = NO_PUSH;
-    firstLoop=false;
+  if(item->size == sizeof(unsigned char))
+    return *value;
+  return *(int *)value;
 }
 /**
- * @brief Slicer setting configuration menu 
+ * @brief writes the value of a menu item 
  * 
+ * @param item menu item 
+ * @param value new value 
  */
-void MenuSlicerConfig()
+void MenuSetValue(const MENU_ITEM *item, int value)
 {
-  static bool firstLoop=false;
-  do
-  {
-    if(!firstLoop)
-    {
-      firstLoop = true;
-      lcdClear();
-      lcd.setCursor(1,0);
-      lcd.print("---Slicer setting--");
-      lcd.setCursor(1,1);
-      lcd.print("Blacklash correct.");
-      lcd.setCursor(1,2);
-      lcd.print("Motor Speed");
-      lcd.setCursor(1,3);
-      lcd.print("NTC");
-      arrowIndexRow =1;
-      ArrowIndex(FORCE);
-    }
+  unsigned char *address = MenuValueAddress(item);
 
-    ArrowIndex(0);
-      
-    if(gknobPsuh == PUSH)
-    {
-      firstLoop=false;
-      gknobPsuh = NO_PUSH;
-      switch (arrowIndexRow)
-      {
-        case 1:
-        MenuBacklash();
-        break;
-        case 2: 
-        MenuMotorSpeed();
-        break;
-        case 3:
-        MenuSlicerConfig();
-        break;
-        default :
-        break;
-      }
-    }
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  }while(gknobPsuh != LONG_PUSH && gbtnBackPressed == 1);
-  do
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  while (!gbtnBackPressed);
-  gknobPsuh = NO_PUSH;
-  firstLoop=false;
+  if(item->size == sizeof(unsigned char))
+    *address = value;
+  else 
+    *(int *)address = value;
 }
 /**
- * @brief motor backlash correction selection menu 
+ * @brief index of the current choice of a choice item 
  * 
+ * @param item menu item 
+ * @return unsigned char 1 if the value is the second choice, else 0 
  */
-void MenuBacklash()
+unsigned char MenuChoiceIndex(const MENU_ITEM *item)
 {
-   static bool firstLoop=false;
-   do
-    {
-      if(!firstLoop)
-      {
-        firstLoop = true;
-        lcdClear();
-        lcd.setCursor(1,0);
-        lcd.print("---Backlash set.--");
-        lcd.setCursor(1,1);
-        lcd.print("Blacklash CW");
-        lcd.setCursor(1,2);
-        lcd.print("Blacklash CCW");
-        arrowIndexRow =1;
-        ArrowIndex(FORCE);
-      }
+  int choice = item->choiceValue[1];
+  //compared as it is stored (MODE_TRIMMING in an unsigned char)
+  if(item->size == sizeof(unsigned char))
+    choice = (unsigned char)choice;
+  return MenuGetValue(item) == choice;
+}
+/**
+ * @brief prints a value followed by its unit and clears the end of the line 
+ * 
+ * @param item menu item 
+ * @param value value or choice index 
+ * @param column first column of the value 
+ * @param row LCD row 
+ */
+void MenuPrintValue(const MENU_ITEM *item, int value, unsigned char column, unsigned char row)
+{
+  unsigned char length;
 
-      ArrowIndex(0);
-      
-      if(gknobPsuh == PUSH)
-      {
-        firstLoop=false;
-        gknobPsuh = NO_PUSH;
-        switch (arrowIndexRow)
-        {
-          case 1:
-          backlashCwConfig();
-          break;
-          case 2: 
-          backlashCcwConfig();
-          break;
-          case 3:
-          break;
-          default :
-          break;
-        }
-      }
-      gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-    }while(gknobPsuh != LONG_PUSH&&gbtnBackPressed == 1 );
-    do
-      gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-    while (!gbtnBackPressed);
-    gknobPsuh = NO_PUSH;
-    firstLoop=false; 
+  lcd.setCursor(column,row);
+  if(item->type == ITEM_CHOICE)
+    length = lcd.print(item->choice[value]);
+  else 
+    length = lcd.print(value);
+  if(item->unit)
+  {
+    length += lcd.print(" ");
+    length += lcd.print(item->unit);
+  }
+  while(column+length < 20)
+    length += lcd.print(" ");
 }
 /**
- * @brief motor backlash correction in counter wise  
+ * @brief displays a page, its title and the items in the window 
  * 
+ * @param level open page 
  */
-void backlashCwConfig()
+void MenuDrawPage(MENU_LEVEL *level)
 {
-  int backlashCw=machineConfig.BacklashCW;
+  const MENU_PAGE *page = level->page;
+  const MENU_ITEM *item;
+  unsigned char row;
+
+  PROFILE_BEGIN(PROFILE_LCD);
   lcdClear();
   lcd.setCursor(0,0);
-  lcd.print("--Backlash CW set.-");
-  lcd.setCursor(1,2);
-  lcd.print("Backlash = ");
-  lcd.setCursor(12,2);
-  lcd.print(machineConfig.BacklashCW);
-  //allows you to change mode 
-  do{
-    if(knobRotation != NO_ROTATION)
+  lcd.print(page->title);
+  for(row=1; row<=MAX_ROW_INDEX_LCD && level->top+row-1 < page->count; row++)
+  {
+    item = &page->items[level->top+row-1];
+    lcd.setCursor(1,row);
+    lcd.print(item->label);
+    //the values are shown next to their label
+    if(item->type == ITEM_VALUE || item->type == ITEM_POSITION)
     {
-      if(knobRotation == CW)
-      backlashCw++;
-      else if (knobRotation == CCW)
-       backlashCw--;
-      if(backlashCw<0)
-        backlashCw=0;
-      if(knobRotation != NO_ROTATION)
-      {
-        knobRotation=NO_ROTATION;
-        lcd.setCursor(12,2);
-        lcd.print(backlashCw);
-        RemoveZero(backlashCw,12,2);
-      }
+      lcd.print(" = ");
+      MenuPrintValue(item, MenuGetValue(item), strlen(item->label)+4, row);
     }
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  }while (gknobPsuh!=PUSH && gbtnBackPressed == 1 );
-  do
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  while (!gbtnBackPressed);
-  gknobPsuh = NO_PUSH;
-  machineConfig.BacklashCW = backlashCw;
+    else if(item->type == ITEM_CHOICE)
+    {
+      lcd.print(" = ");
+      MenuPrintValue(item, MenuChoiceIndex(item), strlen(item->label)+4, row);
+    }
+  }
+  //displays the cursor on the selected item 
+  lcd.setCursor(0,level->selected-level->top+1);
+  lcd.write((byte)0);
+  PROFILE_END(PROFILE_LCD);
 }
 /**
- * @brief motor backlash correction in contrary counter wise 
+ * @brief displays the editor of a value item 
  * 
+ * @param level open item 
  */
-void backlashCcwConfig()
+void MenuDrawEditor(MENU_LEVEL *level)
 {
-  int backlashCcw=machineConfig.BacklashCCW;
+  const MENU_ITEM *item = level->item;
+
   lcdClear();
   lcd.setCursor(0,0);
-  lcd.print("-Backlash CCW set.-");
-  lcd.setCursor(1,2);
-  lcd.print("Backlash = ");
-  lcd.setCursor(12,2);
-  lcd.print(backlashCcw);
-  //allows you to change backlash ccw 
-  do{
-    if(knobRotation != NO_ROTATION)
-    {
-      if(knobRotation == CW)
-      backlashCcw++;
-      else if (knobRotation == CCW)
-       backlashCcw--;
-      if(backlashCcw<0)
-        backlashCcw=0;
-      if(knobRotation != NO_ROTATION)
-      {
-        knobRotation=NO_ROTATION;
-        lcd.setCursor(12,2);
-        lcd.print(backlashCcw);
-        RemoveZero(backlashCcw,12,2);
-      }
-    }
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  }while (gknobPsuh!=PUSH && gbtnBackPressed == 1);
-  do
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  while (!gbtnBackPressed);
-  gknobPsuh = NO_PUSH;
-  machineConfig.BacklashCCW = backlashCcw;
+  if(level->page)
+    lcd.print(level->page->title);
+  else 
+    lcd.print(item->label);
+  if(item->type == ITEM_POSITION)
+  {
+    //tells the user how to select the position 
+    lcd.setCursor(1,1);
+    lcd.print("place the blade and");
+    lcd.setCursor(1,3);
+    lcd.print("press the knob");
+  }
+  lcd.setCursor(0,2);
+  lcd.write((byte)0);
+  lcd.print(item->label);
+  lcd.print(" = ");
+  MenuPrintValue(item, menuEditValue, strlen(item->label)+4, 2);
 }
 /**
- * @brief motor parameter selection menu 
+ * @brief opens a page on top of the current menu 
  * 
+ * @param page page descriptor 
  */
-void MenuMotorSpeed()
+void MenuOpen(const MENU_PAGE *page)
 {
-   static bool firstLoop=false;
-   do
-    {
-      if(!firstLoop)
-      {
-        firstLoop = true;
-        lcdClear();
-        lcd.setCursor(1,0);
-        lcd.print("---Motor Speed--");
-        lcd.setCursor(1,1);
-        lcd.print("Homing Speed");
-        lcd.setCursor(1,2);
-        lcd.print("Moving Speed");
-        arrowIndexRow =1;
-        ArrowIndex(FORCE);
-      }
+  MENU_LEVEL *level;
 
-      ArrowIndex(0);
-      
-      if(gknobPsuh == PUSH)
-      {
-        firstLoop=false;
-        gknobPsuh = NO_PUSH;
-        switch (arrowIndexRow)
-        {
-          case 1:
-          MotorHomingSpeed();
-          break;
-          case 2: 
-          MotorMovingSpeed();
-          break;
-          case 3:
-          break;
-          default :
-          break;
-        }
-      }
-      gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-    }while(gknobPsuh != LONG_PUSH && gbtnBackPressed == 1);
-    do
-      gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-    while (!gbtnBackPressed);
-    gknobPsuh = NO_PUSH;
-    firstLoop=false; 
+  if(menuLevel >= MENU_DEPTH-1)
+    return;
+  level = &menuStack[++menuLevel];
+  level->page = page;
+  level->item = NULL;
+  level->selected = page->firstSelected;
+  level->top = 0;
+  if(level->selected >= MAX_ROW_INDEX_LCD)
+    level->top = level->selected-MAX_ROW_INDEX_LCD+1;
+  MenuDrawPage(level);
 }
 /**
- * @brief allows the user to change the motor speed for continuous movement 
+ * @brief opens the editor or the menu function of an item on top of the current menu 
  * 
+ * @param item item descriptor 
  */
-void MotorHomingSpeed()
+void MenuOpenItem(const MENU_ITEM *item)
 {
-  int motorHomingSpeed=machineConfig.HomingSpeed;
-  lcdClear();
-  lcd.setCursor(0,0);
-  lcd.print("Motor homing speed");
-  lcd.setCursor(1,2);
-  lcd.print("Motor speed = ");
-  lcd.setCursor(15,2);
-  lcd.print(motorHomingSpeed);
-  //allows you to change motor Homing Speed 
-  do{
-    if(knobRotation != NO_ROTATION)
-    {
-      if(knobRotation == CW)
-      motorHomingSpeed++;
-      else if (knobRotation == CCW)
-       motorHomingSpeed--;
-      if(motorHomingSpeed>100)
-        motorHomingSpeed=100;
-      else if (motorHomingSpeed<0)
-        motorHomingSpeed=0;
-      if(knobRotation != NO_ROTATION)
-      {
-        knobRotation=NO_ROTATION;
-        lcd.setCursor(15,2);
-        lcd.print(motorHomingSpeed);
-        RemoveZero(motorHomingSpeed,15,2);
-      }
-    }
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  }while (gknobPsuh!=PUSH && gbtnBackPressed == 1);
-  do
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  while (!gbtnBackPressed);
+  MENU_LEVEL *level;
+
+  if(menuLevel >= MENU_DEPTH-1)
+    return;
+  level = &menuStack[menuLevel+1];
+  //the editor shows the title of the page of the item 
+  level->page = menuLevel >= 0 ? menuStack[menuLevel].page : NULL;
+  level->item = item;
+  level->selected = 0;
+  level->top = 0;
+  menuLevel++;
+  switch(item->type)
+  {
+    case ITEM_FUNCTION:
+      item->function(MENU_ENTER);
+      break;
+    case ITEM_CHOICE:
+      menuEditValue = MenuChoiceIndex(item);
+      MenuDrawEditor(level);
+      break;
+    case ITEM_POSITION:
+      potDisplayFilter.reset();
+      menuEditValue = MenuGetValue(item);
+      MenuDrawEditor(level);
+      break;
+    default:
+      menuEditValue = MenuGetValue(item);
+      MenuDrawEditor(level);
+      break;
+  }
+}
+/**
+ * @brief closes the current menu, the previous one is redrawn or the home screen if it was the last one 
+ * 
+ */
+void MenuClose()
+{
+  MENU_LEVEL *level;
+
+  if(menuLevel < 0)
+    return;
   gknobPsuh = NO_PUSH;
-  machineConfig.HomingSpeed = motorHomingSpeed;
+  //the back button must be released before the previous menu is updated
+  gwaitBackRelease = true;
+  menuLevel--;
+  if(menuLevel < 0)
+  {
+    HomeScreen();
+    return;
+  }
+  level = &menuStack[menuLevel];
+  if(level->item)
+    level->item->function(MENU_RESUME);
+  else 
+    MenuDrawPage(level);
 }
 /**
- * @brief allows the user to change the speed of the motor for movement when cutting  
+ * @brief tells if a menu is open 
  * 
+ * @return true a menu is open 
  */
-void MotorMovingSpeed()
+bool MenuActive()
 {
-  int motorMovingSpeed=machineConfig.MovingSpeed;
-  lcdClear();
-  lcd.setCursor(0,0);
-  lcd.print("Motor homing speed");
-  lcd.setCursor(1,2);
-  lcd.print("Motor speed = ");
-  lcd.setCursor(15,2);
-  lcd.print(motorMovingSpeed);
-  //allows you to change motor Moving Speed 
-  do{
-    if(knobRotation != NO_ROTATION)
+  return menuLevel >= 0;
+}
+/**
+ * @brief moves the cursor on a page, opens the item selected with a push 
+ * 
+ * @param level open page 
+ */
+void MenuUpdatePage(MENU_LEVEL *level)
+{
+  const MENU_PAGE *page = level->page;
+  const MENU_ITEM *item;
+  unsigned char oldRow = level->selected-level->top+1;
+
+  if(knobDetents != 0)
+  {
+    //clockwise goes down the list, with a rotation effect at the ends 
+    level->selected = (level->selected + knobDetents % page->count + page->count) % page->count;
+    ClearKnobRotation();
+    //scrolls the window when the cursor leaves it 
+    if(level->selected < level->top)
     {
-      if(knobRotation == CW)
-      motorMovingSpeed++;
-      else if (knobRotation == CCW)
-       motorMovingSpeed--;
-      if(motorMovingSpeed>100)
-        motorMovingSpeed=100;
-      else if (motorMovingSpeed<0)
-        motorMovingSpeed=0;
-      if(knobRotation != NO_ROTATION)
-      {
-        knobRotation=NO_ROTATION;
-        lcd.setCursor(15,2);
-        lcd.print(motorMovingSpeed);
-        RemoveZero(motorMovingSpeed,15,2);
-      }
+      level->top = level->selected;
+      MenuDrawPage(level);
     }
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  }while (gknobPsuh!=PUSH&& gbtnBackPressed == 1);
-  do
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  while (!gbtnBackPressed);
-  gknobPsuh = NO_PUSH;
-  machineConfig.MovingSpeed = motorMovingSpeed;
+    else if(level->selected >= level->top+MAX_ROW_INDEX_LCD)
+    {
+      level->top = level->selected-MAX_ROW_INDEX_LCD+1;
+      MenuDrawPage(level);
+    }
+    else 
+    {
+      //deletes the old cursor and displays the new one 
+      lcd.setCursor(0,oldRow);
+      lcd.print(" ");
+      lcd.setCursor(0,level->selected-level->top+1);
+      lcd.write((byte)0);
+    }
+  }
+  if(gknobPsuh == PUSH)
+  {
+    gknobPsuh = NO_PUSH;
+    item = &page->items[level->selected];
+    if(item->type == ITEM_PAGE)
+      MenuOpen(item->child);
+    else 
+      MenuOpenItem(item);
+  }
+  else if(gknobPsuh == LONG_PUSH || !gbtnBackPressed)
+  {
+    if(page->onClose)
+      page->onClose();
+    MenuClose();
+  }
 }
 /**
- * @brief user parameter selection menu 
+ * @brief changes the value edited with the knob, stores it with a push or the back button 
  * 
+ * @param level open item 
  */
-void MenuUserConfig()
+void MenuUpdateEditor(MENU_LEVEL *level)
 {
-  static int menuNumber;
-  //refresh display
-  ViewMenuUserConfig();
-   do
+  const MENU_ITEM *item = level->item;
+  unsigned char column = strlen(item->label)+4;
+
+  if(item->type == ITEM_POSITION)
+  {
+    //displays the value of the potentiometer after filtering 
+    ShowPot(column,2);
+    menuEditValue = gvalAdcMenu;
+  }
+  else if(knobDetents != 0)
+  {
+    if(item->type == ITEM_CHOICE)
     {
-      //display cursor
-      ArrowIndex(0);
-      //refresh diplay
-      if(gflagLowerMenu || gflagUpperMenu)
+      //changes once per detent without taking into account the direction 
+      //of rotation of the encoder. 
+      if(knobDetents % 2)
+        menuEditValue = !menuEditValue;
+    }
+    else 
+    {
+      menuEditValue += knobDelta*item->step;
+      if(menuEditValue <= item->min)
       {
-        menuNumber = !menuNumber;
-        ViewMenuUserConfig();
-        
+        menuEditValue = item->min;
+        buzzer_play(BUZZER_LIMIT);
       }
-      // select menu 
-      if(gknobPsuh == PUSH)
+      if(menuEditValue >= item->max)
       {
-        gknobPsuh = NO_PUSH;
-        if(!menuNumber)
-        {
-          switch (arrowIndexRow)
-          {
-            case 1:
-            MenuMode();
-            break;
-            case 2: 
-            MenuThickness();
-            break;
-            case 3:
-            MenuThreshold();
-            break;
-            default :
-            UserConfigScreenOne();
-            break;
-          }
-        }
-        else 
-        {
-          switch (arrowIndexRow)
-          {
-            case 1:
-            MenuThickness();
-            break;
-            case 2:
-            MenuThreshold();
-            break;
-            case 3:
-            MenuAlarm();
-            break;
-            default:
-            UserConfigScreenTwo();
-            break;
-          }
-        }
-        //refresh display 
-        ViewMenuUserConfig();
-        gknobPsuh = NO_PUSH;
+        menuEditValue = item->max;
+        buzzer_play(BUZZER_LIMIT);
       }
-     //read back button   
-     gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-    }while(gknobPsuh != LONG_PUSH && gbtnBackPressed == 1);
-    //wait user release  bakc button 
-    do
-     gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-    while (!gbtnBackPressed);
+    }
+    ClearKnobRotation();
+    MenuPrintValue(item, menuEditValue, column, 2);
+  }
+  if(gknobPsuh == PUSH || !gbtnBackPressed)
+  {
+    if(item->type == ITEM_CHOICE)
+      MenuSetValue(item, item->choiceValue[menuEditValue]);
+    else 
+      MenuSetValue(item, menuEditValue);
+    if(item->onSave)
+      item->onSave();
+    buzzer_play(BUZZER_CONFIRM);
+    MenuClose();
+  }
+}
+/**
+ * @brief updates the current menu, called once per user interface pass 
+ * 
+ */
+void MenuRun()
+{
+  MENU_LEVEL *level;
+
+  if(menuLevel < 0)
+    return;
+  gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
+  //waits for the user to release the back button 
+  if(gwaitBackRelease)
+  {
+    if(!gbtnBackPressed)
+      return;
+    gwaitBackRelease = false;
+  }
+  level = &menuStack[menuLevel];
+  if(!level->item)
+    MenuUpdatePage(level);
+  else if(level->item->type == ITEM_FUNCTION)
+    level->item->function(MENU_UPDATE);
+  else 
+    MenuUpdateEditor(level);
+  //the inputs not used by the menu are dropped
+  ClearKnobRotation();
+  if(gknobPsuh == LONG_PUSH)
     gknobPsuh = NO_PUSH;
 }
+/**
+ * @brief stores the drive mode chosen in the menu in the motor board 
+ * 
+ */
+void ApplyDriveMode()
+{
+  motor_2004_board.setStepperDriveMode(MOTOR_A, machineConfig.DriveMode);
+}
+/**
+ * @brief Saves the configuration to the MicroSD card when the setting menu is closed, 
+ *        the file is written one step per user interface pass 
+ * 
+ */
+void SaveSettings()
+{
+  beginSaveUserAndGeneralSettings("config.cfg", &machineConfig, userConfig, MAX_USER_SETTINGS);
+}
 /**
  * @brief change home screen values 
  * 
@@ -1097,6 +1268,7 @@ void Home( )
  static unsigned int memoFeedValue;
  static unsigned int memoTrimValue;
  static float memoTemperature;
+ static int memoAlarmMinutes=-1;
  static int memoMode;
  
  if(memoFeedValue != userConfig[currentUser].thicknessNormalMode)
@@ -1135,6 +1307,8 @@ void Home( )
    }
    //RemoveZero(ntcSensor.measure.Temp,7,2);
  }
+ if(memoAlarmMinutes != galarmMinutes)
+   ShowAlarmMinutes();
  if(memoMode != userConfig[currentUser].mode)
  {
    lcd.setCursor(5,0);
@@ -1147,6 +1321,7 @@ void Home( )
  memoFeedValue = userConfig[currentUser].thicknessNormalMode;
  memoTrimValue = userConfig[currentUser].thicknessTrimmingMode;
  memoTemperature = ntcSensor.measure.Temp;
+ memoAlarmMinutes = galarmMinutes;
  memoMode = userConfig[currentUser].mode; 
 }
 /**
@@ -1155,6 +1330,7 @@ void Home( )
  */
 void HomeScreen()
 {
+  PROFILE_BEGIN(PROFILE_LCD);
   lcdClear();
   lcd.setCursor(0,0);
   lcd.print("Mode=");
@@ -1177,788 +1353,412 @@ void HomeScreen()
   lcd.print("Temp =      C");
   lcd.setCursor(6,2);
   lcd.print(ntcSensor.measure.Temp,1);
+  ShowAlarmMinutes();
   //lcd.write(0xa1);
+  PROFILE_END(PROFILE_LCD);
 }
 /**
- * @brief allows to change the fixed text between screen one and screen two of MenuUserConfig
- * 
- */
-void ViewMenuUserConfig()
-{
- // static bool firstLoop=false;
-  static bool flagScreenTwo=false;
-   
-  if(gflagUpperMenu ||  gflagLowerMenu)
-  {
-    //firstLoop=false;
-    flagScreenTwo= !flagScreenTwo;
-  }
-    
-    //firstLoop=true;
-    if(!flagScreenTwo)
-    {
-      UserConfigScreenOne();
-    }
-    else 
-    {
-      UserConfigScreenTwo();
-    }
-    ArrowIndex(FORCE);        
-  
-}
-/**
- * @brief fixed text display menu user config screen one of MenuUserConfig
- * 
- */
-void UserConfigScreenOne()
-{
-    lcdClear();
-    lcd.home();
-    lcd.setCursor(0,0);
-    lcd.print("----user setting---");
-    lcd.setCursor(1,1);
-    lcd.print("Mode = ");
-    if(userConfig[currentUser].mode==MODE_NORMAL)
-    {
-      lcd.print("NORMAL");
-    }
-    else
-    {
-       lcd.print("TRIMMING");
-    }
-    
-    lcd.setCursor(1,2);
-    lcd.print("Thickness");
-    lcd.setCursor(1,3);
-    lcd.print("Thresholds");
-}
-/**
- * @brief fixed text display menu user config screen two of MenuUserConfig
- * 
+ * @brief displays the minutes left until the temperature alarm after the temperature, 
+ *        blank without estimate 
  */
-void UserConfigScreenTwo()
+void ShowAlarmMinutes()
 {
-    lcdClear();
-    lcd.setCursor(0,0);
-    lcd.print("----user setting---");
-    lcd.setCursor(1,1);
-    lcd.print("Thickness");
-    lcd.setCursor(1,2);
-    lcd.print("Thresholds");
-    lcd.setCursor(1,3);
-    lcd.print("Alarm = ");
-    if(userConfig[currentUser].alarmState)
-    {
-      lcd.print("ON");
-    }
-    else 
-    {
-      lcd.print("OFF");
-    }
-  
+  lcd.setCursor(14,2);
+  lcd.print("      ");
+  if(galarmMinutes<0)
+    return;
+  lcd.setCursor(14,2);
+  lcd.print("~");
+  lcd.print(galarmMinutes);
+  lcd.print("m");
 }
 /**
- * @brief fixed text display menu mode 
- * 
+ * @brief fixed text display of the diagnostics screen, cutting cycle statistics 
  * 
  */
-void MenuMode()
+void DiagnosticsScreen()
 {
-  static bool toggle = true;
+  PROFILE_BEGIN(PROFILE_LCD);
   lcdClear();
   lcd.setCursor(0,0);
-  lcd.print("--------Mode------");
-  lcd.setCursor(1,2);
-  lcd.print("Mode : ");
-  lcd.setCursor(8,2);
-  if(userConfig[currentUser].mode == NORMAL_MODE)
-  {
-    lcd.print("Normal");
-  }
-  else
-  {
-    lcd.print("Triming");
-  }
-  //allows you to change mode 
-  do{
-    if(knobRotation != NO_ROTATION)
-    {
-      knobRotation = NO_ROTATION;
-      toggle = !toggle;
-      //changes without taking into account the direction 
-      //of rotation of the encoder. 
-      if(toggle)
-      {
-        myString = "Normal  ";
-        userConfig[currentUser].mode = MODE_NORMAL;
-      }
-      else 
-      {     
-        myString = "Triming";
-        userConfig[currentUser].mode = MODE_TRIMMING;
-      }
-      lcd.setCursor(8,2);
-      lcd.print(myString);
-    }
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  }while (gknobPsuh!=PUSH && gbtnBackPressed == 1);
-  do
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  while (!gbtnBackPressed);
-
-}
-/**
- * @brief Menu Select User, show basic information about 
- *        current user
- * 
- */
-void MenuSelectUser()
-{
-  int screenNum=0;
-  int timer;
-  int oldTimer=0;
-  int i; 
-  lcd.setCursor(0,0);
-  lcd.print("-----Select User----");
+  lcd.print("Diag.   Timeouts=");
   lcd.setCursor(0,1);
-  lcd.print("User : ");
-  //loads the values of the different users
-  for(i=0;i<MAX_USER_SETTINGS;i++)
-  {
-    getUserSettingsFromConfig("config.cfg", &userConfig[i], i);
-  }
-  lcd.print(userConfig[currentUser].name);
-  do
-  {
-    timer= millis();
-    //allows you to change users
-    if(knobRotation == CW)
-    {
-      currentUser++;
-    }
-    else if(knobRotation == CCW)
-    {
-      currentUser--;
-    }
-    //security for not being off index
-    if(currentUser<0)
-    {
-      currentUser = MAX_USER_SETTINGS-1;
-    }
-    else if(currentUser>MAX_USER_SETTINGS-1)
-    {
-      currentUser=0;
-    }
-    if(knobRotation!=NO_ROTATION)
-    {
-      
-      getUserSettingsFromConfig("config.cfg", &userConfig[currentUser], currentUser);
-      lcd.setCursor(7,1);
-      lcd.print("             ");
-      lcd.setCursor(7,1);
-      lcd.print(userConfig[currentUser].name);
-      knobRotation = NO_ROTATION;
-      screenNum=0;
-    }
-    //allows the user's configuration to be displayed by scrolling on the screen.
-    //Every second, the information shifts upwards. 
-    if((timer-oldTimer)>=1000)
-    {
-      //deletes the lines 2 and 3 of the LCD 
-      lcd.setCursor(0,2);
-      lcd.print("                    ");
-      lcd.setCursor(0,3);
-      lcd.print("                    ");
-      oldTimer=timer;
-      switch (screenNum)
-      {
-        case 0:
-          lcd.setCursor(0,2);
-          lcd.print("Mode : ");
-          if(userConfig[currentUser].mode==MODE_NORMAL)
-          {
-            lcd.print("Normal");
-            
-          }
-          else 
-          {
-            lcd.print("Trimming");
-            
-          }
-          lcd.setCursor(0,3);
-          lcd.print("Thick. Nor. =     um");
-          lcd.setCursor(14,3);
-          lcd.print(userConfig[currentUser].thicknessNormalMode);
-        break;
-        case 1:
-          lcd.setCursor(0,2);
-          lcd.print("Thick. Nor. =     um");
-          lcd.setCursor(14,2);
-          lcd.print(userConfig[currentUser].thicknessNormalMode);
-          lcd.setCursor(0,3);
-          lcd.print("Thick. Tri. =     um");
-          lcd.setCursor(14,3);
-          lcd.print(userConfig[currentUser].thicknessTrimmingMode);
-        break;
-        case 2:
-          lcd.setCursor(0,2);
-          lcd.print("Thick. Tri. =     um");
-          lcd.setCursor(14,2);
-          lcd.print(userConfig[currentUser].thicknessTrimmingMode);
-          lcd.setCursor(0,3);
-          lcd.print("Thres. cut. =     ");
-          lcd.setCursor(14,3);
-          lcd.print(userConfig[currentUser].thresholdToCut);
-        break;
-        case 3:
-          lcd.setCursor(0,2);
-          lcd.print("Thres. cut. =     ");
-          lcd.setCursor(14,2);
-          lcd.print(userConfig[currentUser].thresholdToCut);
-          lcd.setCursor(0,3);
-          lcd.print("Thres. rew. =     ");
-          lcd.setCursor(14,3);
-          lcd.print(userConfig[currentUser].thresholdToRewind);
-        break;
-        case 4:
-          lcd.setCursor(0,2);
-          lcd.print("Thres. rew. =     ");
-          lcd.setCursor(14,2);
-          lcd.print(userConfig[currentUser].thresholdToRewind);
-          lcd.setCursor(0,3);
-          lcd.print("Alam : ");
-          if(userConfig[currentUser].alarmState == ALARM_ON)
-          {
-            lcd.print("On");
-          }
-          else 
-          {
-            lcd.print("Off");
-          }
-        break;
-        case 5:
-          lcd.setCursor(0,2);
-          lcd.print("Alam : ");
-          if(userConfig[currentUser].alarmState == ALARM_ON)
-          {
-            lcd.print("On");
-          }
-          else 
-          {
-            lcd.print("Off");
-          }
-          lcd.setCursor(0,3);
-          lcd.print("Mode : ");
-          if(userConfig[currentUser].mode==MODE_NORMAL)
-          {
-            lcd.print("Normal");
-          }
-          else 
-          {
-            lcd.print("Trimming");
-          }
-        break;
-        default:
-          break;
-      }
-      screenNum++;
-      if(screenNum>5)
-      {
-        screenNum=0; 
-      }
-    }
-   gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-
-  } while ( gbtnBackPressed && gknobPsuh != PUSH);
-  do
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  while (!gbtnBackPressed);
-  gknobPsuh=NO_PUSH;
-  lcdClear(); 
+  lcd.print("Rate   =      st/min");
+  lcd.setCursor(0,2);
+  lcd.print("Retract=      ms");
+  lcd.setCursor(0,3);
+  lcd.print("Advance=      ms");
+  Diagnostics(FORCE);
+  PROFILE_END(PROFILE_LCD);
 }
 /**
- * @brief fixed text display menu Thickness 
+ * @brief changes the values of the diagnostics screen, stroke rate and motor latencies 
  * 
+ * @param force refreshes now 
  */
-void MenuThickness( )
+void Diagnostics(bool force)
 {
-  lcdClear();
-  arrowIndexRow=1;
-  ArrowIndex(FORCE);
-  lcd.setCursor(0,0);
-  lcd.print("-----Thickness-----");
+  static unsigned long lastRefresh=0;
+  int latency;
 
-  lcd.setCursor(1,1);
-  lcd.print("Normal  = ");
-  lcd.print(userConfig[currentUser].thicknessNormalMode);
-  lcd.print(" um");
-
-  lcd.setCursor(1,2);
-  lcd.print("Triming = ");
-  lcd.print(userConfig[currentUser].thicknessTrimmingMode);
-  lcd.print(" um");
-  //allows you to choose which parameter to change 
-  do
-  {
-      ArrowIndex(0);
-     if(gknobPsuh == PUSH)
-     {
-       gknobPsuh=NO_PUSH;
-       switch (arrowIndexRow)
-       {
-          case 1 :
-          MenuThicknessNormal();
-          break;
-          case 2 : 
-          MenuThicknessTrimming();
-          break;
-          default:
-          break;
-       }
-      //fixed text display
-      lcdClear();
-      ArrowIndex(FORCE);
-      lcd.setCursor(0,0);
-      lcd.print("-----Thickness-----");
-
-      lcd.setCursor(1,1);
-      lcd.print("Normal  = ");
-      lcd.print(userConfig[currentUser].thicknessNormalMode);
-      lcd.print(" um");
-
-      lcd.setCursor(1,2);
-      lcd.print("Triming = ");
-      lcd.print(userConfig[currentUser].thicknessTrimmingMode);
-      lcd.print(" um");
-     }
-     gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  }while (gknobPsuh != LONG_PUSH&&gbtnBackPressed == 1);
-  do
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  while (!gbtnBackPressed);
-}
-/**
- * @brief Normal mode thickness configuration 
- * 
- */
-void MenuThicknessNormal()
-{
-  unsigned int thickness = userConfig[currentUser].thicknessNormalMode;
-  lcdClear();
-  arrowIndexRow=2;
-  ArrowIndex(FORCE);
-  lcd.setCursor(0,0);
-  lcd.print("-Thickness normal--");
-  lcd.setCursor(1,2);
-  lcd.print("Thickness = ");
-  lcd.print(thickness);
-  lcd.setCursor(17,2);
-  lcd.print("um");
-  gknobPsuh=NO_PUSH;
-  //stores the user's thicnkess normal mode value
-  do 
-  {
-    if(knobRotation==CW)
-      thickness++;
-    else if(knobRotation==CCW)
-      thickness--;
-    if(thickness<THICKNESS_MIN)
-      thickness=THICKNESS_MIN;
-    if(thickness>THICKNESS_MAX)
-      thickness=THICKNESS_MAX;   
-    if(knobRotation!=NO_ROTATION)
-    {
-      knobRotation = NO_ROTATION;
-      lcd.setCursor(13,2);
-      lcd.print(thickness);
-      RemoveZero(thickness,13,2);
-      lcd.setCursor(17,2);
-      lcd.print("um");
-    }
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  }while (gknobPsuh!=PUSH && gbtnBackPressed == 1);
-  do
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  while (!gbtnBackPressed);
-  gknobPsuh = NO_PUSH;
-  userConfig[currentUser].thicknessNormalMode=thickness;
+  if(!force && (millis()-lastRefresh) < DIAG_REFRESH_PERIOD)
+    return;
+  lastRefresh = millis();
+  //feed motor moves stopped on a timeout 
+  lcd.setCursor(17,0);
+  lcd.print("   ");
+  lcd.setCursor(17,0);
+  lcd.print(motor_2004_board.getStepperTimeoutCount(MOTOR_A));
+  //strokes per minute 
+  lcd.setCursor(9,1);
+  lcd.print("     ");
+  lcd.setCursor(9,1);
+  lcd.print(telemetry_strokesPerMinute(&cycleTelemetry));
+  //threshold to rewind until the end of the retraction 
+  latency = telemetry_latency_ms(&cycleTelemetry, PHASE_REWIND, PHASE_RETRACT_DONE);
+  lcd.setCursor(9,2);
+  lcd.print("     ");
+  lcd.setCursor(9,2);
+  if(latency<0)
+    lcd.print("--");
+  else
+    lcd.print(latency);
+  //threshold to cut until the end of the advance 
+  latency = telemetry_latency_ms(&cycleTelemetry, PHASE_CUT_START, PHASE_ADVANCE_DONE);
+  lcd.setCursor(9,3);
+  lcd.print("     ");
+  lcd.setCursor(9,3);
+  if(latency<0)
+    lcd.print("--");
+  else
+    lcd.print(latency);
 }
 /**
- * @brief trimming mode thickness configuration 
+ * @brief fixed text display of the profile page, hidden page of the diagnostics screen 
  * 
  */
-void MenuThicknessTrimming()
+void ProfilerScreen()
 {
-  unsigned int thickness = userConfig[currentUser].thicknessTrimmingMode;
-  // display fiexd text 
   lcdClear();
-  arrowIndexRow=2;
-  ArrowIndex(FORCE);
   lcd.setCursor(0,0);
-  lcd.print("-Thickness trimming");
-  lcd.setCursor(1,2);
-  lcd.print("Thickness = ");
-  lcd.print(thickness);
-  lcd.setCursor(17,2);
-  lcd.print("um");
-  gknobPsuh=NO_PUSH;
-  //stores the user's thickness trimming mode value 
-  do 
-  {
-    if(knobRotation==CW)
-      thickness++;
-    else if(knobRotation==CCW)
-      thickness--;
-    if(thickness<THICKNESS_MIN)
-      thickness=THICKNESS_MIN;
-    if(thickness>THICKNESS_MAX)
-      thickness=THICKNESS_MAX;   
-    if(knobRotation!=NO_ROTATION)
-    {
-      knobRotation = NO_ROTATION;
-      lcd.setCursor(13,2);
-      lcd.print(thickness);
-      RemoveZero(thickness,13,2);
-      lcd.setCursor(17,2);
-      lcd.print("um");
-    }
-    //Read back button
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  }while (gknobPsuh!=PUSH && gbtnBackPressed == 1);
-  do
-  //wait user waits for the user to release the button 
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  while (!gbtnBackPressed);
-  gknobPsuh = NO_PUSH;
-  userConfig[currentUser].thicknessTrimmingMode=thickness;
+  lcd.print("Profile   Min=");
+  lcd.setCursor(9,1);
+  lcd.print("Mean=");
+  lcd.setCursor(0,2);
+  lcd.print("[us]      Max=");
+  lcd.setCursor(16,3);
+  lcd.print("log2");
+  Profiler(FORCE);
 }
 /**
- * @brief Selection menu for thresholds 
+ * @brief changes the values of the profile page, min, max, mean and histogram of the selected 
+ *        probe, the knob selects the probe 
  * 
+ * @param force refreshes now 
  */
-void MenuThreshold()
+void Profiler(bool force)
 {
-  //fixed text display 
-  lcdClear();
-  arrowIndexRow=1;
-  ArrowIndex(FORCE);
-  lcd.setCursor(0,0);
-  lcd.print("-----Threshold-----");
+  static unsigned long lastRefresh=0;
+  const PROFILE_PROBE *probe;
+  unsigned long highest=0;
+  unsigned char bucket;
 
-  lcd.setCursor(1,1);
-  lcd.print("Threshold to cut");
-
-  lcd.setCursor(1,2);
-  lcd.print("Threshold to rewind");
-  do
+  if(knobDetents != 0)
   {
-      ArrowIndex(0);
-     if(gknobPsuh == PUSH)
-     {
-       gknobPsuh=NO_PUSH;
-       switch (arrowIndexRow)
-       {
-          case 1 :
-          ScreenThreshold();
-          MenuThresholdToCut();
-          break;
-          case 2 : 
-          ScreenThreshold();
-          MenuThresholdToRewind();
-          break;
-          default:
-          break;
-       }
-      //fixed text display
-      lcdClear();
-      ArrowIndex(FORCE);
-      lcd.setCursor(0,0);
-      lcd.print("-----Threshold------");
-
-      lcd.setCursor(1,1);
-      lcd.print("Threshold to cut");
-
-      lcd.setCursor(1,2);
-      lcd.print("Threshold to revwind ");
-     }
-     gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  }while (gknobPsuh != LONG_PUSH && gbtnBackPressed == 1);
-  do
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  while (!gbtnBackPressed);
-  
-  
-}
-/**
- * @brief tells the user how to select thresholds 
- * 
- */
-void ScreenThreshold()
-{
-  //tells the user how to select thresholds 
-  lcdClear();
+    gprofileProbe = (gprofileProbe + knobDetents % PROFILE_PROBES + PROFILE_PROBES) % PROFILE_PROBES;
+    ClearKnobRotation();
+    force = true;
+  }
+  if(!force && (millis()-lastRefresh) < DIAG_REFRESH_PERIOD)
+    return;
+  lastRefresh = millis();
+  probe = profiler_probe(gprofileProbe);
   lcd.setCursor(0,1);
-  lcd.print("place the blade and");
-  lcd.setCursor(0,2);
-  lcd.print("Press validation");
-  lcd.setCursor(0,3);
-  lcd.print("button");
-  do
-  {
-    delay(10);    
-  }while(gknobPsuh != PUSH);
-  gknobPsuh=NO_PUSH;
-}
-/**
- * @brief Threshold to cut setting menu 
- * 
- */
-void MenuThresholdToCut()
-{
-  //fixed text display
-  lcdClear();
+  lcd.print("     ");
   lcd.setCursor(0,1);
-  lcd.write((byte)0);
-  lcd.setCursor(0,0);
-  lcd.print("--Threshold to cut--");
-  lcd.setCursor(1,1);
-  lcd.print("Position = ");
-  gknobPsuh=NO_PUSH;
-  //stores the user's threshold to cut value
-  do 
+  lcd.print(profiler_name(gprofileProbe));
+  ShowProfileValue(probe->count ? probe->min_us : 0, 14, 0);
+  ShowProfileValue(profiler_mean_us(gprofileProbe), 14, 1);
+  ShowProfileValue(probe->max_us, 14, 2);
+  //one digit per log2 bucket, 1..9 relative to the largest bucket, blank if empty 
+  for(bucket=0;bucket<PROFILE_BUCKETS;bucket++)
   {
-    //Reading the analog value of the position potentiometer
-    gvalAdc = analogRead(ADC_POT);
-    //displays the value of the potentiometer and after averaging 
-    ShowPot(12,1);
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  }while (gknobPsuh!=PUSH && gbtnBackPressed == 1);
-  do
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  while (!gbtnBackPressed);
-  //saves the current user value
-  userConfig[currentUser].thresholdToCut = gvalAdc;
-  gknobPsuh = NO_PUSH;
+    if(probe->histogram[bucket] > highest)
+      highest = probe->histogram[bucket];
+  }
+  lcd.setCursor(0,3);
+  for(bucket=0;bucket<PROFILE_BUCKETS;bucket++)
+  {
+    if(!probe->histogram[bucket])
+      lcd.print(' ');
+    else
+      lcd.print((char)('1' + (unsigned long long)probe->histogram[bucket] * 8 / highest));
+  }
 }
 /**
- * @brief Threshold to Rewind setting menu 
+ * @brief displays a time of the profile page in a field of 6 characters 
  * 
+ * @param value time [us], limited to the field 
+ * @param column 
+ * @param row 
  */
-void MenuThresholdToRewind()
+void ShowProfileValue(unsigned long value, unsigned char column, unsigned char row)
 {
-  //fixed text display
-  lcdClear();
-  lcd.setCursor(0,1);
-  lcd.write((byte)0);
-  lcd.setCursor(0,0);
-  lcd.print(" Threshold to rewind");
-  lcd.setCursor(1,1);
-  lcd.print("Position = ");
-  gknobPsuh=NO_PUSH;
-  //stores the user's threshold to cut value
-  do 
-  {
-    //Reading the analog value of the position potentiometer
-    gvalAdc = analogRead(ADC_POT);
-    //displays the value of the potentiometer and after averaging 
-    ShowPot(12,1);
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  }while (gknobPsuh!=PUSH && gbtnBackPressed == 1);
-  do
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  while (!gbtnBackPressed);
-  //saves the current user value
-   userConfig[currentUser].thresholdToRewind = gvalAdc;
-  gknobPsuh=NO_PUSH;
+  lcd.setCursor(column,row);
+  lcd.print("      ");
+  lcd.setCursor(column,row);
+  lcd.print(value > PROFILE_FIELD_MAX ? PROFILE_FIELD_MAX : value);
 }
 /**
- * @brief Alarm setup menu
+ * @brief commands received on the serial port: 'p' sends the loop profile, the execution 
+ *        times of the tasks and the blade predictor statistics, 'c' clears them, 't' sends 
+ *        the I2C trace (built with -DI2C_TRACE) 
  * 
  */
-void MenuAlarm()
+void SerialCommands()
 {
-  lcdClear();
-  arrowIndexRow=1;
-  ArrowIndex(FORCE);
-  lcd.setCursor(0,0);
-  lcd.print("-------Alarm--------");
+  char line[64];
+  unsigned char i;
 
-  lcd.setCursor(1,1);
-  lcd.print("Alarm State : ");
-  if(userConfig[currentUser].alarmState)
-  {
-    lcd.print("ON");
-  }
-  else 
+  if(!Serial.available())
+    return;
+  switch(Serial.read())
   {
-    lcd.print("OFF");
-  }
-  lcd.setCursor(1,2);
-  lcd.print("Alarm Setting");
-  do
-  {
-      ArrowIndex(0);
-     if(gknobPsuh == PUSH)
-     {
-       gknobPsuh=NO_PUSH;
-       switch (arrowIndexRow)
-       {
-          case 1 :
-          MenuAlarmState();
-          break;
-          case 2 : 
-          MenuAlarmSetting();
-          break;
-          default:
-          break;
-       }
-      //fixed text display
-      lcdClear();
-      arrowIndexRow=1;
-      ArrowIndex(FORCE);
-      lcd.setCursor(0,0);
-      lcd.print("-------Alarm--------");
-
-      lcd.setCursor(1,1);
-      lcd.print("Alarm State : ");
-      if(userConfig[currentUser].alarmState)
-      {
-        lcd.print("ON");
-      }
-      else 
+    case 'p':
+      profiler_print(&Serial);
+      Serial.println("# tasks: name runs deadline_misses last_us worst_us");
+      for(i=0;i<NB_OF_TASK;i++)
       {
-        lcd.print("OFF");
+        snprintf(line, sizeof(line), "%s %lu %u %lu %lu", taskTable[i].name, taskTable[i].runCount,
+                 taskTable[i].deadlineMiss, taskTable[i].lastExec_us, taskTable[i].worstExec_us);
+        Serial.println(line);
       }
-      lcd.setCursor(1,2);
-      lcd.print("Alarm Setting");
-     }
-     gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  }while (gknobPsuh != LONG_PUSH && gbtnBackPressed == 1);
-  do
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  while (!gbtnBackPressed);
+      //threshold crossings predicted ahead of the blade, mean error positive if late 
+      Serial.println("# blade predictor: predicted hits misses late mean_error_ms");
+      snprintf(line, sizeof(line), "%u %u %u %u %d", bladePredictor.predicted, bladePredictor.hits,
+               bladePredictor.misses, bladePredictor.late, predictor_meanError_ms(&bladePredictor));
+      Serial.println(line);
+      break;
+    case 'c':
+      profiler_clear();
+      scheduler_resetStats(taskTable, NB_OF_TASK);
+      predictor_resetStats(&bladePredictor);
+      break;
+#ifdef I2C_TRACE
+    case 't':
+      i2cTrace_dump(&Serial);
+      break;
+#endif
+    default:
+      break;
+  }
 }
 /**
- * @brief configures the alarm status 
+ * @brief Menu Select User, show basic information about 
+ *        current user
  * 
  */
-void MenuAlarmState()
+void MenuSelectUser(unsigned char menuEvent)
 {
-  static bool toggle = true;
-  gknobPsuh=NO_PUSH;
-  //displays fixed text 
-  lcdClear();
-  lcd.setCursor(0,2);
-  lcd.write((byte)0);
-  lcd.setCursor(0,0);
-  lcd.print("-------Alarm--------");
-  lcd.setCursor(1,2);
-  lcd.print("Alarm =");
-  lcd.setCursor(9,2);
-  if(userConfig[currentUser].alarmState)
+  static int screenNum;
+  static int oldTimer;
+  //users loaded from the SD card, one per pass so that the cutting task keeps running 
+  static int usersLoaded;
+  int timer;
+  if(menuEvent != MENU_UPDATE)
   {
-    lcd.print("ON");
+    screenNum=0;
+    oldTimer=0;
+    //loads the values of the different users when the menu is opened 
+    if(menuEvent == MENU_ENTER)
+      usersLoaded=0;
+    lcdClear();
+    lcd.setCursor(0,0);
+    lcd.print("-----Select User----");
+    lcd.setCursor(0,1);
+    lcd.print("User : ");
+    if(usersLoaded >= MAX_USER_SETTINGS)
+      lcd.print(userConfig[currentUser].name);
+    return;
   }
-  else 
+  if(usersLoaded < MAX_USER_SETTINGS)
   {
-    lcd.print("OFF");
-  }
-  
-  do{
-  //activates or deactivates the temperature alarmState 
-    if(knobRotation != NO_ROTATION)
+    //the file is not read while the settings are being saved, the knob waits for the last user 
+    if(!isSavingUserAndGeneralSettings())
     {
-      knobRotation = NO_ROTATION;
-      toggle = !toggle;
-      //changes without taking into account the direction 
-      //of rotation of the encoder. 
-      if(toggle)
+      getUserSettingsFromConfig("config.cfg", &userConfig[usersLoaded], usersLoaded);
+      usersLoaded++;
+      if(usersLoaded >= MAX_USER_SETTINGS)
       {
-        myString = "ON ";
-        userConfig[currentUser].alarmState = ALARM_ON;
-      }
-      else 
-      {     
-        myString = "OFF";
-        userConfig[currentUser].alarmState = Alarm_OFF;
+        lcd.setCursor(7,1);
+        lcd.print(userConfig[currentUser].name);
       }
-      lcd.setCursor(9,2);
-      lcd.print(myString);
     }
-    //Read back button 
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  }while (gknobPsuh != PUSH&&gbtnBackPressed == 1);
-  //read back button 
-  do
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  while (!gbtnBackPressed);
-  gknobPsuh =NO_PUSH;
+    return;
+  }
+  timer= millis();
+  //allows you to change users, one user per detent
+  //security for not being off index
+  currentUser = (currentUser + knobDetents % MAX_USER_SETTINGS + MAX_USER_SETTINGS) % MAX_USER_SETTINGS;
+  if(knobDetents != 0)
+  {
+    lcd.setCursor(7,1);
+    lcd.print("             ");
+    lcd.setCursor(7,1);
+    lcd.print(userConfig[currentUser].name);
+    ClearKnobRotation();
+    screenNum=0;
+  }
+  //allows the user's configuration to be displayed by scrolling on the screen.
+  //Every second, the information shifts upwards. 
+  if((timer-oldTimer)>=1000)
+  {
+    //deletes the lines 2 and 3 of the LCD 
+    lcd.setCursor(0,2);
+    lcd.print("                    ");
+    lcd.setCursor(0,3);
+    lcd.print("                    ");
+    oldTimer=timer;
+    switch (screenNum)
+    {
+      case 0:
+        lcd.setCursor(0,2);
+        lcd.print("Mode : ");
+        if(userConfig[currentUser].mode==MODE_NORMAL)
+        {
+          lcd.print("Normal");
+          
+        }
+        else 
+        {
+          lcd.print("Trimming");
+          
+        }
+        lcd.setCursor(0,3);
+        lcd.print("Thick. Nor. =     um");
+        lcd.setCursor(14,3);
+        lcd.print(userConfig[currentUser].thicknessNormalMode);
+      break;
+      case 1:
+        lcd.setCursor(0,2);
+        lcd.print("Thick. Nor. =     um");
+        lcd.setCursor(14,2);
+        lcd.print(userConfig[currentUser].thicknessNormalMode);
+        lcd.setCursor(0,3);
+        lcd.print("Thick. Tri. =     um");
+        lcd.setCursor(14,3);
+        lcd.print(userConfig[currentUser].thicknessTrimmingMode);
+      break;
+      case 2:
+        lcd.setCursor(0,2);
+        lcd.print("Thick. Tri. =     um");
+        lcd.setCursor(14,2);
+        lcd.print(userConfig[currentUser].thicknessTrimmingMode);
+        lcd.setCursor(0,3);
+        lcd.print("Thres. cut. =     ");
+        lcd.setCursor(14,3);
+        lcd.print(userConfig[currentUser].thresholdToCut);
+      break;
+      case 3:
+        lcd.setCursor(0,2);
+        lcd.print("Thres. cut. =     ");
+        lcd.setCursor(14,2);
+        lcd.print(userConfig[currentUser].thresholdToCut);
+        lcd.setCursor(0,3);
+        lcd.print("Thres. rew. =     ");
+        lcd.setCursor(14,3);
+        lcd.print(userConfig[currentUser].thresholdToRewind);
+      break;
+      case 4:
+        lcd.setCursor(0,2);
+        lcd.print("Thres. rew. =     ");
+        lcd.setCursor(14,2);
+        lcd.print(userConfig[currentUser].thresholdToRewind);
+        lcd.setCursor(0,3);
+        lcd.print("Alam : ");
+        if(userConfig[currentUser].alarmState == ALARM_ON)
+        {
+          lcd.print("On");
+        }
+        else 
+        {
+          lcd.print("Off");
+        }
+      break;
+      case 5:
+        lcd.setCursor(0,2);
+        lcd.print("Alam : ");
+        if(userConfig[currentUser].alarmState == ALARM_ON)
+        {
+          lcd.print("On");
+        }
+        else 
+        {
+          lcd.print("Off");
+        }
+        lcd.setCursor(0,3);
+        lcd.print("Mode : ");
+        if(userConfig[currentUser].mode==MODE_NORMAL)
+        {
+          lcd.print("Normal");
+        }
+        else 
+        {
+          lcd.print("Trimming");
+        }
+      break;
+      default:
+        break;
+    }
+    screenNum++;
+    if(screenNum>5)
+    {
+      screenNum=0; 
+    }
+  }
+  if(!gbtnBackPressed || gknobPsuh == PUSH)
+    MenuClose();
 }
 /**
- * @brief Alarm temperatur setting
- * 
+ * @brief converts a feed (thickness, backlash) to a number of motor steps 
+ *        according to the drive mode of the machine 
+ * @param feed feed in full step unit 
+ * @return unsigned int number of steps to do 
  */
-void MenuAlarmSetting()
+unsigned int FeedToSteps(unsigned int feed)
 {
-  int tempAlarmDegree= userConfig[currentUser].tempAlarmDegree;
-  lcdClear();
-  lcd.setCursor(0,2);
-  lcd.write((byte)0);
-  lcd.setCursor(1,0);
-  lcd.print("---Temp. setting--");
-  lcd.setCursor(1,2);
-  lcd.print("Temp. = ");
-  lcd.print(userConfig[currentUser].tempAlarmDegree);
-  lcd.setCursor(9,2);
-  do
-  {
-    if(knobRotation == CW)
-      tempAlarmDegree++;
-    else if (knobRotation == CCW)
-      tempAlarmDegree--;
-    if(knobRotation != NO_ROTATION)
-    {
-      knobRotation=NO_ROTATION;
-      lcd.setCursor(9,2);
-      lcd.print(tempAlarmDegree);
-      RemoveZero(tempAlarmDegree,9,2);
-    }
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  }while (gknobPsuh != PUSH && gbtnBackPressed == 1);
-  do
-    gbtnBackPressed =  mcp230xx_getChannel(&mcp23017config,BTN_ROLL);
-  while (!gbtnBackPressed);
-  gknobPsuh = NO_PUSH;
-  userConfig[currentUser].tempAlarmDegree = tempAlarmDegree;
+  if(machineConfig.DriveMode == DRIVE_MODE_HALF_STEP)
+    return feed*HALF_STEP_RATIO;
+  return feed;
 }
 /**
- * @brief calculates an average over 5 values of the analog converter.
- * @param valAdc ADC value
- * @return unsigned int Avaraged ADC value
+ * @brief state of the feed motor before a manual move, a move timeout is signalled 
+ *        by the fault tone and no new move is started 
+ * @return true if the motor is stopped 
  */
-unsigned int AverageAdc (unsigned int valAdc)
+bool FeedMotorStopped()
 {
-  unsigned int averageTempo;
-  static unsigned int cntLoop=0;
-  static unsigned int tabValAdc[AVERAGE_SIZE];
-  unsigned int average;
-  unsigned char i;
-  
-  averageTempo=0;
-  //stock the last 5 values 
-  tabValAdc[cntLoop++]=valAdc;
-  //Reset cntLoop
-  if(cntLoop>=AVERAGE_SIZE)
-  {    
-    cntLoop=0;
-  }
-  //avarages
-  for( i=0;i<AVERAGE_SIZE;i++)
+  int motorState = motor_2004_board.getPredictedStepperState(MOTOR_A);
+
+  if(motorState == STEPPER_TIMEOUT)
   {
-    averageTempo += tabValAdc[i];
+    motor_2004_board.flushStepperQueue(MOTOR_A);
+    buzzer_play(BUZZER_FAULT);
+    return false;
   }
-  average = averageTempo/AVERAGE_SIZE;
-  return average;
+  return motorState == STEPPER_STOPPED;
+}
+/**
+ * @brief a move of the automatic cycle is running or queued on the feed motor, a manual move 
+ *        would flush the queued advance and the cycle would start its next move after it 
+ * @return true if the manual moves must be ignored 
+ */
+bool CycleMoveActive()
+{
+  if(modeAutoMan != MODE_AUTO)
+    return false;
+  return motor_2004_board.getPredictedStepperState(MOTOR_A) != STEPPER_STOPPED ||
+         motor_2004_board.getQueuedRotationCount(MOTOR_A) > 0;
 }
 /**
  * @brief  removes the remaining zeros from the display 
@@ -1991,25 +1791,6 @@ void RemoveZero( int value, unsigned char column, unsigned char raw)
      lcd.print(" ");
    }
 }
-/**
- * @brief determines the direction of rotation 
- *        of the rotary encoder 
- */
-void knobRotationDetection()
-{
-  bool knobChannelA;
-  bool knobChannelB;
-  
-  //input reading 
-  knobChannelA = digitalRead (KNOB_CHANNEL_A);
-  knobChannelB = digitalRead (KNOB_CHANNEL_B); 
-  //Clock wise 
-  if(knobChannelA == knobChannelB)
-  {   knobRotation = CW;}
-  //contrary clock wise 
-  else
-  { knobRotation = CCW;}
-}
 /**
  * @brief Detects whether the button has been 
  *        pressed for a short or long time
@@ -2038,68 +1819,63 @@ void knobSwitchDetection()
       //test if the button has been pressed long enough
       if((timer-timerMemo) > LONG_PUSH_TIME)
       {
-          gknobPsuh = LONG_PUSH;
+          inputEvents_push(EVENT_KNOB_PUSH, LONG_PUSH, timer);
       }
       //bounce eliminator
       else if((timer-timerMemo) > BOUNCE_ELIM_TIME)
       {
-         gknobPsuh = PUSH;
+         inputEvents_push(EVENT_KNOB_PUSH, PUSH, timer);
       }
       
   }  
 }
 /**
- * @brief draws and moves the cursor on the LCD
- * 
- * @param force forces the cursor display 
+ * @brief gives the knob events of the queue to knobDetents, knobDelta and gknobPsuh.
+ *        All the pending rotations are summed, the rotations that follow a push are only 
+ *        taken once the push is consumed 
  */
-void ArrowIndex(bool force)
+void UpdateKnobInputs()
 {
-  gflagUpperMenu=false;
-  gflagLowerMenu=false;
-  //test if the encoder has rotated 
-  if(knobRotation!=NO_ROTATION )
-  {  
-    //the encoder has turned clockwise 
-    if(knobRotation==CW)
-    { arrowIndexRow ++; }
-    //the encoder has turned contrary clockwise 
-    else if(knobRotation==CCW)
-    { arrowIndexRow --; }
-    //Test if the cursor index is higher than the number 
-    //of lines on the screen to create a rotation effect.
-    if(arrowIndexRow<1)
-    { arrowIndexRow= MAX_ROW_INDEX_LCD; }
-    else if (arrowIndexRow>MAX_ROW_INDEX_LCD)
-    { arrowIndexRow=1; }
-    //indicates that we have rotated up or down the screen
-    if(arrowOldPosition==MAX_ROW_INDEX_LCD && arrowIndexRow==1 )
-    {
-      gflagUpperMenu=false;
-      gflagLowerMenu=true;
-    }
-    else if (arrowOldPosition==1 && arrowIndexRow==MAX_ROW_INDEX_LCD)
+  INPUT_EVENT event;
+  static int lastRotation=NO_ROTATION;
+  static unsigned long lastRotationTime=0;
+  int step;
+
+  //the queue stops at a push until it is consumed 
+  while(gknobPsuh == NO_PUSH && inputEvents_peek(&event))
+  {
+    if(event.type == EVENT_KNOB_ROTATION)
     {
-      gflagUpperMenu=true;
-      gflagLowerMenu=false;
+      //larger steps when the knob turns fast in the same direction 
+      if(event.value == lastRotation)
+        step = knobDecoder_step(event.time_ms - lastRotationTime);
+      else
+        step = 1;
+      lastRotation = event.value;
+      lastRotationTime = event.time_ms;
+      if(event.value == CW)
+      {
+        knobDetents++;
+        knobDelta += step;
+      }
+      else 
+      {
+        knobDetents--;
+        knobDelta -= step;
+      }
     }
-    //displays the cursor at the new position 
-    lcd.setCursor(0,arrowIndexRow);
-    lcd.write((byte)0);
-    //deletes the old cursor 
-    lcd.setCursor(0,arrowOldPosition);
-    lcd.print(" ");
-    knobRotation=NO_ROTATION;
-    arrowOldPosition=arrowIndexRow;
+    else if(event.type == EVENT_KNOB_PUSH)
+      gknobPsuh = event.value;
+    inputEvents_pop(NULL);
   }
-  else if(force)
-  {
-    //forces the display of the cursor 
-    lcd.setCursor(0,arrowIndexRow);
-    lcd.write((byte)0);
-    arrowOldPosition=arrowIndexRow;
-  }
- 
+}
+/**
+ * @brief the knob rotations have been used 
+ */
+void ClearKnobRotation()
+{
+  knobDetents = 0;
+  knobDelta = 0;
 }
 /**
  * @brief replaces the lcd.clear() function of the library 
@@ -2125,39 +1901,18 @@ void lcdClear()
  */
 void ShowPot(unsigned char columns, unsigned char raw)
 {  
-  gvalAdc = analogRead(ADC_POT);
-  //calculates the average of the adc values
-  gvalAdc = AverageAdc(gvalAdc);
+  gvalAdcMenu = adcSampler_value(ADC_POT);
+  //filters the adc values
+  gvalAdcMenu = potDisplayFilter.apply(gvalAdcMenu);
+  //position units of the thresholds 
+  gvalAdcMenu >>= SECTION_THRESHOLD_SHIFT;
   //convert to string 
-  myString = String (gvalAdc);
+  myString = String (gvalAdcMenu);
   lcd.setCursor (columns,raw);
   //Serial.print(columns);
   //lcd.print(myString);
   lcd.print(myString);
-  RemoveZero(gvalAdc,columns,raw);
-}
-/**
- * @brief Calculation of NTC température
- * 
- * @param UR10K Ref. Resistor input voltage
- * @param NTC NTC circuit settings (RTh beta, RTh@0degree, RRef value)
- * @return float Temperature in degree C
- */
-float calcNTCTemp(int UR10K, NTCsensor * NTC){
-
-  //Variables
-  float RT, ln, TX, T0, Rvoltage;
-
-  T0 = NTC->settings.Th0 + 273.15; //Temperature T0 from datasheet, conversion from Celsius to kelvin
-  Rvoltage = (float)UR10K/1000.0;
-  RT = (VCC - Rvoltage) / (Rvoltage/NTC->settings.RRef);
-  NTC->measure.RThValue=RT;
-  ln = log(RT / NTC->settings.RTh0);
-  TX = (1 / ((ln / NTC->settings.RThbeta) + (1 / T0))); //Temperature from thermistor
-  TX = TX - 273.15; //Conversion to Celsius
-  NTC->measure.Temp=TX;
-  return (TX);
-
+  RemoveZero(gvalAdcMenu,columns,raw);
 }
 /**
  * @brief Port init Arduino MKRZERO
@@ -2167,6 +1922,8 @@ void PortInit()
 {
   pinMode(ADC_POT,INPUT);
   pinMode(ADC_NTC,INPUT);
+  pinMode(ADC_NTC_HEAD,INPUT);
+  pinMode(ADC_KNIFE,INPUT);
   pinMode(Buzzer,OUTPUT);
   pinMode(MCP23017_INTB,INPUT);
   pinMode(MCP23017_INTA,INPUT);
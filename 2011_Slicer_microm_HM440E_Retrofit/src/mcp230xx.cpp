@@ -24,6 +24,7 @@
 #define INTCAP  0x08		// Interrupt captured value for port register
 #define GPIO    0x09		// General purpose IO port register
 #define OLAT    0x0A		// Output latch register, (Use to modify the outputs)
+#define IOCON_BANK0 0x0B	// IO configuration register of the MCP23017 in the power on map (BANK=0)
 
 #include "mcp230xx.h"
 #include "device_drivers/src/arduino-i2c.h"
@@ -78,6 +79,8 @@ int mcp23017_init(device_mcp230xx *mcp230xxconfig){
     unsigned int gpioIntEnable = mcp230xxconfig->gpioIntEnable;
     
     // Disable auto-incrementation, use two separate bank BANK=1, SEQOP=1
+    // IOCON is at 0x0B after a reset (BANK=0), 0x0B is not used once BANK=1 is set
+    err+= i2c_write(0, deviceAddress, IOCON_BANK0, 0xA0);
     err+= i2c_write(0, deviceAddress, IOCON, 0xA0);
 
  //BANK 1 CONFIGURATION (GPIO-A)
@@ -0,0 +1,80 @@
+/**
+ * @file ntcTable.cpp
+ * @brief Build of the ADC code -> centi-degree table from the NTC and reference resistor settings, and
+ *        linear interpolation of a measure between two points of the table.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - build and interpolation of the NTC table
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <math.h>
+#include "ntcTable.h"
+
+// Normalised codes between two table points
+#define NTC_TABLE_STEP (1UL << (NTC_TABLE_CODE_BITS - NTC_TABLE_BITS))
+
+/**
+ * @brief Compute the table from the NTC and divider parameters (NTC to VCC, reference resistor to
+ *        ground, ADC on the reference resistor)
+ *
+ * @param table table to fill
+ * @param beta NTC beta coefficient [K]
+ * @param rTh0 NTC resistance at th0 [ohm]
+ * @param th0 reference temperature of rTh0 [degree]
+ * @param rRef reference resistor [ohm]
+ */
+void ntcTable_build(NTC_TABLE *table, int beta, int rTh0, int th0, int rRef){
+  float T0 = th0 + 273.15;
+  float ratio, RT, TX;
+  int i;
+
+  for(i=0; i<NTC_TABLE_SIZE; i++){
+    // voltage on the reference resistor / VCC, the reference voltage cancels out
+    ratio = (float)(i * NTC_TABLE_STEP) / (1UL << NTC_TABLE_CODE_BITS);
+    if(ratio <= 0){
+      table->centiDegrees[i] = NTC_TABLE_MIN;
+      continue;
+    }
+    if(ratio >= 1){
+      table->centiDegrees[i] = NTC_TABLE_MAX;
+      continue;
+    }
+    RT = rRef * (1 - ratio) / ratio;
+    TX = 1 / ((log(RT / rTh0) / beta) + (1 / T0)) - 273.15;
+    TX = TX * 100;
+    if(TX < NTC_TABLE_MIN)
+      TX = NTC_TABLE_MIN;
+    else if(TX > NTC_TABLE_MAX)
+      TX = NTC_TABLE_MAX;
+    // rounded to the nearest centi-degree
+    table->centiDegrees[i] = (short)(TX < 0 ? TX - 0.5 : TX + 0.5);
+  }
+}
+
+/**
+ * @brief Temperature of an ADC code, interpolated between the two nearest table points
+ *
+ * @param table table built by ntcTable_build
+ * @param code ADC code
+ * @param codeBits ADC resolution, the full scale code is the reference voltage
+ * @return int temperature [0.01 degree]
+ */
+int ntcTable_centiDegrees(const NTC_TABLE *table, unsigned int code, unsigned char codeBits){
+  unsigned long normalised;
+  unsigned int index;
+  unsigned long fraction;
+  int low, high;
+
+  // full scale code = 2^NTC_TABLE_CODE_BITS
+  normalised = ((unsigned long)code << NTC_TABLE_CODE_BITS) / ((1UL << codeBits) - 1);
+  index = normalised / NTC_TABLE_STEP;
+  if(index >= NTC_TABLE_SIZE - 1)
+    return table->centiDegrees[NTC_TABLE_SIZE - 1];
+  fraction = normalised % NTC_TABLE_STEP;
+  low = table->centiDegrees[index];
+  high = table->centiDegrees[index + 1];
+  return low + (int)((high - low) * (long)fraction / (long)NTC_TABLE_STEP);
+}
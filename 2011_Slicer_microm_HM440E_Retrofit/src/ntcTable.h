@@ -0,0 +1,33 @@
+/**
+ * @file ntcTable.h
+ * @brief Integer NTC temperature conversion. The beta equation is evaluated once per table point
+ *        when the table is built, the measure is then a linear interpolation between two points
+ *        of the ADC code -> centi-degree table, without float or log() on the Cortex-M0+.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - NTC lookup table, replaces the float calcNTCTemp()
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef ntcTable_h
+#define ntcTable_h
+
+// Resolution of the normalised ADC code (ratio of the reference voltage over the NTC divider)
+#define NTC_TABLE_CODE_BITS 16
+// Number of table intervals = 2^NTC_TABLE_BITS (256 intervals: < 0.03 degree error from -40 to 60 degree)
+#define NTC_TABLE_BITS 8
+#define NTC_TABLE_SIZE ((1 << NTC_TABLE_BITS) + 1)
+// Table limits, also returned when the divider is open or shorted [0.01 degree]
+#define NTC_TABLE_MIN -27315
+#define NTC_TABLE_MAX 32767
+
+typedef struct t_ntcTable{
+    short centiDegrees[NTC_TABLE_SIZE];     // Temperature at each normalised code step [0.01 degree]
+} NTC_TABLE;
+
+extern void ntcTable_build(NTC_TABLE *table, int beta, int rTh0, int th0, int rRef);
+extern int ntcTable_centiDegrees(const NTC_TABLE *table, unsigned int code, unsigned char codeBits);
+
+#endif
@@ -0,0 +1,197 @@
+/**
+ * @file sectioningStateMachine.cpp
+ * @brief Steps of the cutting cycle: threshold detection on the position samples, feed moves sent
+ *        through the actuators, section count and phase time stamps.
+ * @version 0.3
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - steps of the cutting cycle
+ *         19.10.2026 - feed motor timeout stops the cycle (SECTION_FAULT)
+ *         19.10.2026 - new thresholds taken while the cycle waits for the blade only
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "sectioningStateMachine.h"
+
+/**
+ * @brief Construct a new cutting cycle
+ *
+ * @param inputs limit switch and feed motor state
+ * @param actuators feed motor, led and section counter
+ * @param predictor blade crossing predictor, updated with each position processed
+ * @param telemetry cycle phases time stamps, NULL if not recorded
+ */
+SectioningStateMachine::SectioningStateMachine(SectioningInputs *inputs, SectioningActuators *actuators, BLADEPREDICTOR *predictor,
+                                               CYCLE_TELEMETRY *telemetry){
+    this->inputs = inputs;
+    this->actuators = actuators;
+    this->predictor = predictor;
+    this->telemetry = telemetry;
+    started = false;
+    cutLedOn = false;
+    step = SECTION_WAIT_CUT;
+    speed = 0;
+    thresholdToCut = 0;
+    thresholdToRewind = 0;
+}
+
+/**
+ * @brief Restart the cycle, waiting for the threshold to cut, the only way out of a fault
+ */
+void SectioningStateMachine::reset(){
+    step = SECTION_WAIT_CUT;
+}
+
+/**
+ * @brief Current step of the cycle
+ *
+ * @return unsigned char SECTION_xxx step
+ */
+unsigned char SectioningStateMachine::getStep(){
+    return step;
+}
+
+/**
+ * @brief Time stamp a cycle phase in the telemetry
+ *
+ * @param phase PHASE_xxx
+ */
+void SectioningStateMachine::recordPhase(unsigned char phase){
+    if(telemetry)
+        telemetry_record(telemetry, phase, inputs->timeMs());
+}
+
+/**
+ * @brief End of the feed move, a timeout stops the cycle
+ *
+ * @return true if the feed motor is stopped and the cycle can go on
+ */
+bool SectioningStateMachine::feedMotorStopped(){
+    int state = inputs->feedMotorState();
+
+    if(state < 0){
+        actuators->feedFault();
+        step = SECTION_FAULT;
+        return false;
+    }
+    return state == 0;
+}
+
+/**
+ * @brief Process one blade position sample
+ *
+ * @param machineConfig backlash and feed speed
+ * @param userSetting thickness and thresholds
+ * @param retraction specimen retracted during the blade rewind
+ * @param position blade position sample
+ */
+void SectioningStateMachine::process(const SLICERCONFIG *machineConfig, const SETTINGS *userSetting, bool retraction, unsigned int position){
+    unsigned int backlash = machineConfig->BacklashCW;
+    unsigned int thickness;
+
+    if(!started){
+        started = true;
+        speed = machineConfig->MovingSpeed;
+        thresholdToCut = userSetting->thresholdToCut;
+        thresholdToRewind = userSetting->thresholdToRewind;
+    }
+
+    if(userSetting->mode == MODE_NORMAL)
+        thickness = userSetting->thicknessNormalMode;
+    else
+        thickness = userSetting->thicknessTrimmingMode;
+    // new thresholds, only taken while the cycle waits for the blade: a feed move running is
+    // finished first, and the cycle goes on from its step (the crossings are detected on the
+    // blade position, restarting at the cut with the blade down would cut at once)
+    if(step == SECTION_WAIT_CUT || step == SECTION_WAIT_REWIND){
+        thresholdToCut = userSetting->thresholdToCut;
+        thresholdToRewind = userSetting->thresholdToRewind;
+    }
+    // blade velocity, the thresholds are detected before the crossing to hide the motor command latency
+    predictor_update(predictor, position);
+
+    switch(step){
+        case SECTION_WAIT_REWIND:
+            if(predictor_crossing(predictor, thresholdToRewind << SECTION_THRESHOLD_SHIFT, CROSS_RISING) != CROSS_NONE){
+                if(!retraction)
+                    step = SECTION_WAIT_RETRACT;
+                else
+                    step = SECTION_RETRACT;
+                actuators->countSection();
+                recordPhase(PHASE_REWIND);
+            }
+            break;
+
+        case SECTION_RETRACT:
+            if(inputs->canRetract()){
+                if(speed > 0){
+                    backlash = machineConfig->BacklashCCW;
+                    speed = -speed;
+                }else backlash = 0;
+                actuators->feedMove(speed, thickness+backlash);
+                // preloads the advance while the retraction is running
+                actuators->queueFeedMove(-speed, thickness+thickness+machineConfig->BacklashCW);
+            }
+            step = SECTION_WAIT_RETRACT;
+            break;
+
+        case SECTION_WAIT_RETRACT:
+            if(feedMotorStopped()){
+                // without retraction, preloads the advance while waiting for the blade
+                if(!retraction && !inputs->feedQueuedMoves()){
+                    if(speed < 0)
+                        backlash = machineConfig->BacklashCW;
+                    else
+                        backlash = 0;
+                    actuators->queueFeedMove(machineConfig->MovingSpeed, thickness+backlash);
+                }
+                recordPhase(PHASE_RETRACT_DONE);
+                step = SECTION_WAIT_CUT;
+            }
+            break;
+
+        case SECTION_WAIT_CUT:
+            // the led is only written once, this step runs for each sample
+            if(!cutLedOn){
+                actuators->setCutLed(true);
+                cutLedOn = true;
+            }
+            if(predictor_crossing(predictor, thresholdToCut << SECTION_THRESHOLD_SHIFT, CROSS_FALLING) != CROSS_NONE){
+                recordPhase(PHASE_CUT_START);
+                step = SECTION_CUT;
+            }
+            break;
+
+        case SECTION_CUT:
+            actuators->setCutLed(false);
+            cutLedOn = false;
+            step = SECTION_ADVANCE;
+            break;
+
+        case SECTION_ADVANCE:
+            if(speed < 0){
+                speed = -speed;
+                backlash = machineConfig->BacklashCW;
+            }else backlash = 0;
+            if(!retraction){
+                speed = machineConfig->MovingSpeed;
+                actuators->countSection();
+            }else thickness += thickness;
+            actuators->feedMove(speed, thickness+backlash);
+            step = SECTION_WAIT_ADVANCE;
+            break;
+
+        case SECTION_WAIT_ADVANCE:
+            if(feedMotorStopped()){
+                recordPhase(PHASE_ADVANCE_DONE);
+                step = SECTION_WAIT_REWIND;
+            }
+            break;
+
+        // the specimen position is lost, no move until the cycle is reset
+        case SECTION_FAULT:
+        default:
+            break;
+    }
+}
@@ -0,0 +1,92 @@
+/**
+ * @file sectioningStateMachine.h
+ * @brief Cutting cycle of the automatic mode: the specimen is retracted when the blade goes up
+ *        and advanced by the section thickness when the blade comes down to cut. The hardware is
+ *        accessed through the SectioningInputs and SectioningActuators interfaces only.
+ * @version 0.2
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - cutting cycle extracted from ThresholdDetection() of main.cpp
+ *         19.10.2026 - feed motor timeout stops the cycle (SECTION_FAULT)
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef sectioningStateMachine_h
+#define sectioningStateMachine_h
+
+#include "jsonConfigSDcard.h"
+#include "bladePredictor.h"
+#include "cycleTelemetry.h"
+#include "adcSampler.h"
+
+// Cutting cycle steps
+#define SECTION_WAIT_REWIND 1       // Blade going up to the threshold to rewind
+#define SECTION_RETRACT 2           // Specimen retraction
+#define SECTION_WAIT_RETRACT 3      // Waiting for the end of the retraction
+#define SECTION_WAIT_CUT 4          // Blade going down to the threshold to cut
+#define SECTION_CUT 5               // Threshold to cut reached
+#define SECTION_ADVANCE 6           // Specimen advance
+#define SECTION_WAIT_ADVANCE 7      // Waiting for the end of the advance
+#define SECTION_FAULT 8             // Feed motor timeout, cycle stopped until reset
+
+// The thresholds are set in 10 bit position units, the positions are 16 bit ADC results
+#define SECTION_THRESHOLD_SHIFT (ADC_SAMPLER_RESULT_BITS - 10)
+
+/**
+ * @brief Inputs read by the cutting cycle
+ */
+class SectioningInputs{
+    public:
+        // Lower limit switch free, the specimen can be retracted
+        virtual bool canRetract() = 0;
+        // Feed motor state, 0 if stopped or expected to be stopped, > 0 if running,
+        // < 0 if the move timed out and the motor has been stopped (position lost)
+        virtual int feedMotorState() = 0;
+        // Number of feed moves waiting in the motor queue
+        virtual int feedQueuedMoves() = 0;
+        // Time base of the cycle telemetry [ms]
+        virtual unsigned long timeMs() = 0;
+};
+
+/**
+ * @brief Outputs driven by the cutting cycle
+ */
+class SectioningActuators{
+    public:
+        // Starts a feed move now [um], the sign of the speed gives the direction
+        virtual void feedMove(int speed, unsigned int feed) = 0;
+        // Queues a feed move started after the current one [um]
+        virtual void queueFeedMove(int speed, unsigned int feed) = 0;
+        // Waiting for the cut led
+        virtual void setCutLed(bool on) = 0;
+        // One more section cut
+        virtual void countSection() = 0;
+        // Feed motor timeout, the queued moves are dropped and the fault is signalled
+        virtual void feedFault() = 0;
+};
+
+class SectioningStateMachine{
+    public:
+        SectioningStateMachine(SectioningInputs *inputs, SectioningActuators *actuators, BLADEPREDICTOR *predictor,
+                               CYCLE_TELEMETRY *telemetry);
+        void process(const SLICERCONFIG *machineConfig, const SETTINGS *userSetting, bool retraction, unsigned int position);
+        void reset();
+        unsigned char getStep();
+
+    private:
+        SectioningInputs *inputs;
+        SectioningActuators *actuators;
+        BLADEPREDICTOR *predictor;
+        CYCLE_TELEMETRY *telemetry;
+        bool started;
+        unsigned char step;
+        int speed;
+        unsigned int thresholdToCut;
+        unsigned int thresholdToRewind;
+        bool cutLedOn;
+        void recordPhase(unsigned char phase);
+        bool feedMotorStopped();
+};
+
+#endif
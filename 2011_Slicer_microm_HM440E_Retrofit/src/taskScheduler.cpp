@@ -0,0 +1,92 @@
+/**
+ * @file taskScheduler.cpp
+ * @brief Release times of the tasks, selection of the due task with the highest priority, and
+ *        recording of the deadline misses and execution times.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - selection of the due task and statistics
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <Arduino.h>
+#include "taskScheduler.h"
+
+/**
+ * @brief Release all the tasks of the table now and clear the statistics
+ * 
+ * @param taskTable pointer to the task table
+ * @param nbOfTask number of tasks in the table
+ */
+void scheduler_init(TASK *taskTable, unsigned char nbOfTask){
+  unsigned long now = millis();
+  unsigned char i;
+
+  for(i=0;i<nbOfTask;i++){
+    taskTable[i].nextRun_ms = now;
+  }
+  scheduler_resetStats(taskTable, nbOfTask);
+}
+
+/**
+ * @brief Run the due task with the highest priority (the first one of the table if equal)
+ * 
+ * @param taskTable pointer to the task table
+ * @param nbOfTask number of tasks in the table
+ * @return int index of the task run, -1 if no task was due
+ */
+int scheduler_run(TASK *taskTable, unsigned char nbOfTask){
+  unsigned long now = millis();
+  unsigned long start_us;
+  int selected = -1;
+  TASK *task;
+  unsigned char i;
+
+  // Search the due task with the highest priority
+  for(i=0;i<nbOfTask;i++){
+    if((long)(now - taskTable[i].nextRun_ms) >= 0){
+      if(selected < 0 || taskTable[i].priority < taskTable[selected].priority)
+        selected = i;
+    }
+  }
+  if(selected < 0)
+    return -1;
+
+  task = &taskTable[selected];
+
+  // Started more than one period after its release, the missed runs are dropped
+  if(now - task->nextRun_ms >= task->period_ms){
+    task->deadlineMiss++;
+    task->nextRun_ms = now + task->period_ms;
+  }
+  else
+    task->nextRun_ms += task->period_ms;
+
+  start_us = micros();
+  task->function();
+  task->lastExec_us = micros() - start_us;
+
+  if(task->lastExec_us > task->worstExec_us)
+    task->worstExec_us = task->lastExec_us;
+  task->runCount++;
+
+  return selected;
+}
+
+/**
+ * @brief Clear the deadline miss counters and the execution times of all the tasks
+ * 
+ * @param taskTable pointer to the task table
+ * @param nbOfTask number of tasks in the table
+ */
+void scheduler_resetStats(TASK *taskTable, unsigned char nbOfTask){
+  unsigned char i;
+
+  for(i=0;i<nbOfTask;i++){
+    taskTable[i].deadlineMiss = 0;
+    taskTable[i].runCount = 0;
+    taskTable[i].lastExec_us = 0;
+    taskTable[i].worstExec_us = 0;
+  }
+}
@@ -0,0 +1,37 @@
+/**
+ * @file taskScheduler.h
+ * @brief Table driven cooperative scheduler. Each task of the table is run periodically, the due
+ *        task with the highest priority is run first. Deadline misses and execution times are
+ *        recorded for each task.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - task table replacing the monolithic loop()
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef taskScheduler_h
+#define taskScheduler_h
+
+// Task definition and statistics
+typedef struct t_task{
+    const char *name;                   // Task name (diagnostics)
+    void (*function)(void);             // Task function, must return without blocking
+    unsigned long period_ms;            // Run period
+    unsigned char priority;             // 0 is the highest priority
+    unsigned long nextRun_ms;           // Next release time
+    unsigned int deadlineMiss;          // Number of runs started more than one period late
+    unsigned long runCount;             // Number of runs
+    unsigned long lastExec_us;          // Execution time of the last run
+    unsigned long worstExec_us;         // Worst case execution time measured
+} TASK;
+
+// Entry of a task table, the statistics start cleared
+#define TASK_ENTRY(name, fn, period, prio) {name, fn, period, prio, 0, 0, 0, 0, 0}
+
+extern void scheduler_init(TASK *taskTable, unsigned char nbOfTask);
+extern int scheduler_run(TASK *taskTable, unsigned char nbOfTask);
+extern void scheduler_resetStats(TASK *taskTable, unsigned char nbOfTask);
+
+#endif
@@ -0,0 +1,119 @@
+/**
+ * @file tempHistory.cpp
+ * @brief Averaging of the measures over a period, ring buffer of the averages and least squares slope
+ *        of the last samples in integer arithmetic.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - averaging, ring buffer and least squares trend
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "tempHistory.h"
+
+/**
+ * @brief Clear the history
+ *
+ * @param history pointer to the history buffer
+ */
+void tempHistory_init(TEMP_HISTORY *history){
+  history->head = 0;
+  history->count = 0;
+  history->sum = 0;
+  history->measures = 0;
+}
+
+/**
+ * @brief Add a measure, a sample is stored every TEMP_HISTORY_PERIOD_S measures. The oldest
+ *        sample is overwritten when the buffer is full.
+ *
+ * @param history pointer to the history buffer
+ * @param centiDegrees temperature measured
+ */
+void tempHistory_add(TEMP_HISTORY *history, int centiDegrees){
+  history->sum += centiDegrees;
+  history->measures++;
+  if(history->measures < TEMP_HISTORY_PERIOD_S)
+    return;
+  history->centiDegrees[history->head] = history->sum / history->measures;
+  history->head = (history->head+1) % TEMP_HISTORY_SIZE;
+  if(history->count < TEMP_HISTORY_SIZE)
+    history->count++;
+  history->sum = 0;
+  history->measures = 0;
+}
+
+/**
+ * @brief Number of samples stored
+ *
+ * @param history pointer to the history buffer
+ * @return unsigned int samples
+ */
+unsigned int tempHistory_count(TEMP_HISTORY *history){
+  return history->count;
+}
+
+/**
+ * @brief Sample stored age samples before the last one
+ *
+ * @param history pointer to the history buffer
+ * @param age 0 for the last sample
+ * @return int temperature [centi-degrees], 0 if not stored
+ */
+int tempHistory_sample(TEMP_HISTORY *history, unsigned int age){
+  if(age >= history->count)
+    return 0;
+  return history->centiDegrees[(history->head + TEMP_HISTORY_SIZE - 1 - age) % TEMP_HISTORY_SIZE];
+}
+
+/**
+ * @brief Least squares slope of the last TEMP_HISTORY_TREND_SAMPLES samples
+ *
+ * @param history pointer to the history buffer
+ * @param centiDegreesPerHour pointer to the slope, positive when the temperature rises
+ * @return int 0 if computed, -1 if less than TEMP_HISTORY_MIN_TREND samples
+ */
+int tempHistory_slope(TEMP_HISTORY *history, long *centiDegreesPerHour){
+  long long n = history->count < TEMP_HISTORY_TREND_SAMPLES ? history->count : TEMP_HISTORY_TREND_SAMPLES;
+  long long sumX = 0;
+  long long sumY = 0;
+  long long sumXY = 0;
+  long long sumXX = 0;
+  long long x;
+  long long y;
+
+  if(n < TEMP_HISTORY_MIN_TREND)
+    return -1;
+  // x: sample time from the oldest one, in periods
+  for(x=0;x<n;x++){
+    y = tempHistory_sample(history, n - 1 - x);
+    sumX += x;
+    sumY += y;
+    sumXY += x * y;
+    sumXX += x * x;
+  }
+  *centiDegreesPerHour = (n * sumXY - sumX * sumY) * (3600 / TEMP_HISTORY_PERIOD_S) / (n * sumXX - sumX * sumX);
+  return 0;
+}
+
+/**
+ * @brief Time left until the temperature reaches a threshold with the current trend
+ *
+ * @param history pointer to the history buffer
+ * @param thresholdCentiDegrees threshold temperature
+ * @return long time left [s], -1 if the trend does not lead to the threshold or is unknown
+ */
+long tempHistory_timeToReach_s(TEMP_HISTORY *history, int thresholdCentiDegrees){
+  long slope;
+  long distance;
+
+  if(tempHistory_slope(history, &slope) < 0 || slope == 0)
+    return -1;
+  distance = thresholdCentiDegrees - tempHistory_sample(history, 0);
+  if(distance == 0)
+    return 0;
+  if((distance > 0) != (slope > 0))
+    return -1;
+  return distance * 3600 / slope;
+}
@@ -0,0 +1,40 @@
+/**
+ * @file tempHistory.h
+ * @brief Temperature history kept in a RAM ring buffer as centi-degrees. The measures are averaged
+ *        over TEMP_HISTORY_PERIOD_S before being stored. The trend is the least squares slope of
+ *        the last samples, it gives the time left until a threshold is reached.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark 19.10.2026 - temperature history and trend of the diagnostics screen
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef tempHistory_h
+#define tempHistory_h
+
+// Measures averaged per stored sample (one measure per second)
+#define TEMP_HISTORY_PERIOD_S 5
+// Number of samples kept (720 samples of 5s = 1 hour)
+#define TEMP_HISTORY_SIZE 720
+// Samples used for the trend (10 minutes), at least TEMP_HISTORY_MIN_TREND
+#define TEMP_HISTORY_TREND_SAMPLES 120
+#define TEMP_HISTORY_MIN_TREND 12
+
+typedef struct t_tempHistory{
+    short centiDegrees[TEMP_HISTORY_SIZE];
+    unsigned int head;              // Next slot written
+    unsigned int count;             // Number of samples stored
+    long sum;                       // Measures of the sample in progress
+    unsigned char measures;
+} TEMP_HISTORY;
+
+extern void tempHistory_init(TEMP_HISTORY *history);
+extern void tempHistory_add(TEMP_HISTORY *history, int centiDegrees);
+extern unsigned int tempHistory_count(TEMP_HISTORY *history);
+extern int tempHistory_sample(TEMP_HISTORY *history, unsigned int age);
+extern int tempHistory_slope(TEMP_HISTORY *history, long *centiDegreesPerHour);
+extern long tempHistory_timeToReach_s(TEMP_HISTORY *history, int thresholdCentiDegrees);
+
+#endif
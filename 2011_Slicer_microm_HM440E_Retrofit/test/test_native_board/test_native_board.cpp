@@ -0,0 +1,77 @@
+/**
+ * @file test_native_board.cpp
+ * @brief Unit tests of the board stand-in of env:native: the inputs of the MCP23017 model rest
+ *        at the levels main.cpp reads as released, so the firmware can run on the host.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark Released levels of the buttons (GPA0..GPA5, active high) and of the joystick
+ *         (GPB0..GPB3, active low), the stand-in first held Back, Reset and the limit switch
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <unity.h>
+#include "NativeBoard.h"
+#include "mcp230xx.h"
+
+// Inputs of main.cpp on the MCP23017
+#define BTN_GRBTGL 0
+#define BTN_RETREN 1
+#define BTN_ROLL 2
+#define BTN_AUTMAN 3
+#define BTN_RES 4
+#define SW_CALIBRATION 5
+#define JOY_TRIM 8
+#define JOY_GRBUP 9
+#define JOY_STP 10
+#define JOY_GRBDWN 11
+
+extern device_mcp230xx mcp23017config;
+
+void setUp(void){
+}
+
+void tearDown(void){
+}
+
+/**
+ * @brief mcp230xx_getChannel() gives 1 for a low pin: the buttons and the limit switch are
+ *        released at 1, the joystick at 0
+ */
+void test_inputs_released(void){
+  unsigned char channel;
+
+  for(channel=BTN_GRBTGL;channel<=BTN_RES;channel++)
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1, mcp230xx_getChannel(&mcp23017config, channel), "button");
+  TEST_ASSERT_EQUAL_INT_MESSAGE(1, mcp230xx_getChannel(&mcp23017config, SW_CALIBRATION), "limit switch");
+  for(channel=JOY_TRIM;channel<=JOY_GRBDWN;channel++)
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, mcp230xx_getChannel(&mcp23017config, channel), "joystick");
+}
+
+void test_inputs_active(void){
+  nativeExpander.setInput(BTN_RES, HIGH);
+  nativeExpander.setInput(SW_CALIBRATION, HIGH);
+  nativeExpander.setInput(JOY_STP, LOW);
+  TEST_ASSERT_EQUAL_INT(0, mcp230xx_getChannel(&mcp23017config, BTN_RES));
+  TEST_ASSERT_EQUAL_INT(0, mcp230xx_getChannel(&mcp23017config, SW_CALIBRATION));
+  TEST_ASSERT_EQUAL_INT(1, mcp230xx_getChannel(&mcp23017config, JOY_STP));
+  // released again
+  nativeExpander.setInput(BTN_RES, LOW);
+  nativeExpander.setInput(SW_CALIBRATION, LOW);
+  nativeExpander.setInput(JOY_STP, HIGH);
+  TEST_ASSERT_EQUAL_INT(1, mcp230xx_getChannel(&mcp23017config, BTN_RES));
+  TEST_ASSERT_EQUAL_INT(0, mcp230xx_getChannel(&mcp23017config, JOY_STP));
+}
+
+int main(int argc, char **argv){
+  nativeBoard_attach();
+  Wire.begin();
+  mcp23017_init(&mcp23017config);
+  UNITY_BEGIN();
+  RUN_TEST(test_inputs_released);
+  RUN_TEST(test_inputs_active);
+  return UNITY_END();
+}
@@ -0,0 +1,307 @@
+/**
+ * @file test_native_motion.cpp
+ * @brief Unit tests of the board against the PCA9629A models of env:native, on the virtual clock:
+ *        the predicted duration of a single action must match the time the motor really takes,
+ *        the motors of a group start with one write to its sub-address and the emergency stop
+ *        reaches every motor with one write to the all call address.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark The prediction first counted a prescaler the driver does not write, every move was
+ *         predicted twice as long as it lasts
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <Arduino.h>
+#include <string.h>
+#include <Wire.h>
+#include <unity.h>
+#include "NativeBoard.h"
+#include "NativeClock.h"
+#include "cmu_ws_2004_01_V1_board.h"
+
+// Rounding of the prediction and of the step timing [ms]
+#define PREDICTION_TOLERANCE_MS 1
+// Bus addresses counted by the spy (7 bits): the two channels, group 1 and all call
+#define SPY_ADDRESSES 4
+
+// Board with the predicted duration of the running move readable, and writable to fake an overrun
+class testBoard : public board_2004_01_V01{
+  public:
+    unsigned long predictedDuration_ms(unsigned char motor){
+      return MOTOR_QUEUE[motor].moveDuration_ms;
+    }
+    void setPredictedDuration_ms(unsigned char motor, unsigned long duration_ms){
+      MOTOR_QUEUE[motor].moveDuration_ms = duration_ms;
+    }
+};
+
+/**
+ * @brief Counts the writes to the motor addresses, the group 1 sub-address and the all call
+ *        address. Attached after the models, it never answers a read.
+ */
+class writeSpy : public WireDevice{
+  public:
+    const uint8_t addresses[SPY_ADDRESSES] = {0x20, 0x21, PCA9629_SUBADR1 >> 1, PCA9629_ALLCALLADR >> 1};
+    unsigned int writes[SPY_ADDRESSES];
+    uint8_t lastAddress;
+
+    void clear(){
+      memset(writes, 0, sizeof(writes));
+    }
+    unsigned int count(uint8_t address){
+      for(int i=0;i<SPY_ADDRESSES;i++){
+        if(addresses[i] == address)
+          return writes[i];
+      }
+      return 0;
+    }
+    bool acknowledge(uint8_t address){
+      lastAddress = address;
+      for(int i=0;i<SPY_ADDRESSES;i++){
+        if(addresses[i] == address)
+          return true;
+      }
+      return false;
+    }
+    bool receive(const uint8_t *data, size_t count){
+      (void)data;
+      (void)count;
+      for(int i=0;i<SPY_ADDRESSES;i++){
+        if(addresses[i] == lastAddress)
+          writes[i]++;
+      }
+      return true;
+    }
+    size_t request(uint8_t *data, size_t count){
+      (void)data;
+      (void)count;
+      return 0;
+    }
+};
+
+static testBoard board;
+static writeSpy spy;
+
+void setUp(void){
+}
+
+void tearDown(void){
+}
+
+/**
+ * @brief Time until the model of the motor stops [ms], from the end of the command (the
+ *        prediction starts after the MCNTL write)
+ */
+static unsigned long modelledDuration_ms(unsigned long start_us){
+  while(nativeMotor[MOTOR_A].direction() != 0)
+    delayMicroseconds(100);
+  return (micros() - start_us + 500) / 1000;
+}
+
+/**
+ * @brief Single action started by stepperRotation(), predicted and modelled durations
+ */
+static void checkMove(int speed, int steps){
+  char message[48];
+  unsigned long start_us;
+  long position = nativeMotor[MOTOR_A].stepCount();
+
+  board.stepperRotation(MOTOR_A, speed, steps);
+  start_us = micros();
+  snprintf(message, sizeof(message), "speed %d, %d steps", speed, steps);
+  TEST_ASSERT_INT_WITHIN_MESSAGE(PREDICTION_TOLERANCE_MS, modelledDuration_ms(start_us), board.predictedDuration_ms(MOTOR_A), message);
+  TEST_ASSERT_EQUAL_INT_MESSAGE(speed > 0 ? steps : -steps, nativeMotor[MOTOR_A].stepCount() - position, message);
+  TEST_ASSERT_EQUAL_INT(STEPPER_STOPPED, board.getPredictedStepperState(MOTOR_A));
+}
+
+void test_prediction_matches_motor(void){
+  checkMove(100, 60);
+  checkMove(-100, 70);
+  checkMove(50, 200);
+  checkMove(-1, 20);
+}
+
+/**
+ * @brief Queued move started from the preloaded registers
+ */
+void test_prediction_of_queued_move(void){
+  unsigned long start_us;
+
+  TEST_ASSERT_EQUAL_INT(0, board.queueStepperRotation(MOTOR_A, -80, 120));
+  TEST_ASSERT_EQUAL_INT(0, board.startQueuedRotation(MOTOR_A));
+  start_us = micros();
+  TEST_ASSERT_INT_WITHIN(PREDICTION_TOLERANCE_MS, modelledDuration_ms(start_us), board.predictedDuration_ms(MOTOR_A));
+}
+
+/**
+ * @brief The state register is not read before the predicted end, no timeout on time
+ */
+void test_no_timeout_on_time(void){
+  board.stepperRotation(MOTOR_A, 100, 60);
+  TEST_ASSERT_EQUAL_INT(STEPPER_RUNNING, board.getPredictedStepperState(MOTOR_A));
+  delay(board.predictedDuration_ms(MOTOR_A) + PREDICTION_TOLERANCE_MS);
+  TEST_ASSERT_EQUAL_INT(STEPPER_STOPPED, board.getPredictedStepperState(MOTOR_A));
+  TEST_ASSERT_EQUAL_INT(0, board.getStepperTimeoutCount(MOTOR_A));
+}
+
+/**
+ * @brief A move running past the timeout margin is stopped and reported once, the next state
+ *        read is stopped
+ */
+void test_timeout_on_overrun(void){
+  unsigned int timeouts = board.getStepperTimeoutCount(MOTOR_A);
+
+  // 200 steps at the lowest speed last far longer than the faked prediction
+  board.stepperRotation(MOTOR_A, 1, 200);
+  board.setPredictedDuration_ms(MOTOR_A, 10);
+  delay(10 + MOTION_TIMEOUT_MS + PREDICTION_TOLERANCE_MS + 2);
+  TEST_ASSERT_EQUAL_INT(STEPPER_TIMEOUT, board.getPredictedStepperState(MOTOR_A));
+  TEST_ASSERT_EQUAL_UINT(timeouts + 1, board.getStepperTimeoutCount(MOTOR_A));
+  TEST_ASSERT_EQUAL_INT(0, nativeMotor[MOTOR_A].direction());
+  TEST_ASSERT_EQUAL_INT(STEPPER_STOPPED, board.getPredictedStepperState(MOTOR_A));
+}
+
+/**
+ * @brief A motor not fitted is rejected and the fitted motors are not moved
+ */
+void test_motor_not_fitted(void){
+  const unsigned char motor = BOARD_MOTOR_CHANNELS;
+  long position = nativeMotor[MOTOR_A].stepCount();
+
+  board.stepperRotation(motor, 100, 60);
+  TEST_ASSERT_EQUAL_INT(-1, board.queueStepperRotation(motor, 100, 60));
+  TEST_ASSERT_EQUAL_INT(-1, board.startQueuedRotation(motor));
+  TEST_ASSERT_EQUAL_INT(-1, board.getQueuedRotationCount(motor));
+  TEST_ASSERT_EQUAL_INT(-1, board.setStepperGroup(motor, MOTOR_GROUP_1));
+  TEST_ASSERT_EQUAL_INT(-1, board.getStepperState(motor));
+  TEST_ASSERT_EQUAL_INT(-1, board.getPredictedStepperState(motor));
+  TEST_ASSERT_EQUAL_INT(-1, board.setStepperDriveMode(motor, 0));
+  TEST_ASSERT_EQUAL_UINT(0, board.getStepperTimeoutCount(motor));
+  TEST_ASSERT_EQUAL_INT(0, nativeMotor[MOTOR_A].direction());
+  TEST_ASSERT_EQUAL_INT(position, nativeMotor[MOTOR_A].stepCount());
+  TEST_ASSERT_EQUAL_INT(STEPPER_STOPPED, board.getPredictedStepperState(MOTOR_A));
+}
+
+/**
+ * @brief Wait until both motors are stopped and seen stopped by the board
+ */
+static void waitStopped(void){
+  while(nativeMotor[MOTOR_A].direction() != 0 || nativeMotor[MOTOR_B].direction() != 0)
+    delayMicroseconds(100);
+  board.getStepperState(MOTOR_A);
+  board.getStepperState(MOTOR_B);
+}
+
+/**
+ * @brief Both channels of group 1 started with one write to the sub-address, each channel does
+ *        the steps of its own command
+ */
+void test_group_start(void){
+  long positionA, positionB;
+
+  // single action mode on both channels
+  board.stepperRotation(MOTOR_A, 100, 1);
+  board.stepperRotation(MOTOR_B, 100, 1);
+  waitStopped();
+  TEST_ASSERT_EQUAL_INT(0, board.setStepperGroup(MOTOR_A, MOTOR_GROUP_1));
+  TEST_ASSERT_EQUAL_INT(0, board.setStepperGroup(MOTOR_B, MOTOR_GROUP_1));
+  TEST_ASSERT_EQUAL_INT(0, board.queueStepperRotation(MOTOR_A, 80, 100));
+  TEST_ASSERT_EQUAL_INT(0, board.queueStepperRotation(MOTOR_B, 80, 60));
+  positionA = nativeMotor[MOTOR_A].stepCount();
+  positionB = nativeMotor[MOTOR_B].stepCount();
+
+  spy.clear();
+  TEST_ASSERT_EQUAL_INT(0, board.groupStepperStart(MOTOR_GROUP_1));
+  TEST_ASSERT_EQUAL_UINT(1, spy.count(PCA9629_SUBADR1 >> 1));
+  TEST_ASSERT_EQUAL_UINT(0, spy.count(0x20));
+  TEST_ASSERT_EQUAL_UINT(0, spy.count(0x21));
+  TEST_ASSERT_EQUAL_INT(1, nativeMotor[MOTOR_A].direction());
+  TEST_ASSERT_EQUAL_INT(1, nativeMotor[MOTOR_B].direction());
+  TEST_ASSERT_EQUAL_INT(0, board.getQueuedRotationCount(MOTOR_A));
+  TEST_ASSERT_EQUAL_INT(0, board.getQueuedRotationCount(MOTOR_B));
+
+  waitStopped();
+  TEST_ASSERT_EQUAL_INT(100, nativeMotor[MOTOR_A].stepCount() - positionA);
+  TEST_ASSERT_EQUAL_INT(60, nativeMotor[MOTOR_B].stepCount() - positionB);
+}
+
+/**
+ * @brief Group starts rejected: unknown or empty group, member without command, member running,
+ *        members turning in opposite directions. Nothing is written to the group.
+ */
+void test_group_start_rejected(void){
+  spy.clear();
+  TEST_ASSERT_EQUAL_INT(-1, board.groupStepperStart(MOTOR_GROUP_NONE));
+  TEST_ASSERT_EQUAL_INT(-1, board.groupStepperStart(MOTOR_GROUP_3 + 1));
+  TEST_ASSERT_EQUAL_INT(-1, board.groupStepperStart(MOTOR_GROUP_2));
+  TEST_ASSERT_EQUAL_INT(-1, board.setStepperGroup(MOTOR_A, MOTOR_GROUP_3 + 1));
+
+  // MOTOR_B without command
+  TEST_ASSERT_EQUAL_INT(0, board.queueStepperRotation(MOTOR_A, 80, 50));
+  TEST_ASSERT_EQUAL_INT(-1, board.groupStepperStart(MOTOR_GROUP_1));
+
+  // MOTOR_B running, its command is not preloaded
+  board.stepperRotation(MOTOR_B, 80, 200);
+  TEST_ASSERT_EQUAL_INT(0, board.queueStepperRotation(MOTOR_B, 80, 50));
+  TEST_ASSERT_EQUAL_INT(-1, board.groupStepperStart(MOTOR_GROUP_1));
+  waitStopped();
+
+  // mixed directions
+  board.flushStepperQueue(MOTOR_B);
+  TEST_ASSERT_EQUAL_INT(0, board.queueStepperRotation(MOTOR_B, -80, 50));
+  TEST_ASSERT_EQUAL_INT(-1, board.groupStepperStart(MOTOR_GROUP_1));
+
+  TEST_ASSERT_EQUAL_UINT(0, spy.count(PCA9629_SUBADR1 >> 1));
+  TEST_ASSERT_EQUAL_INT(0, nativeMotor[MOTOR_A].direction());
+  TEST_ASSERT_EQUAL_INT(0, nativeMotor[MOTOR_B].direction());
+  TEST_ASSERT_EQUAL_INT(1, board.getQueuedRotationCount(MOTOR_A));
+  TEST_ASSERT_EQUAL_INT(1, board.getQueuedRotationCount(MOTOR_B));
+
+  board.flushStepperQueue(MOTOR_A);
+  board.flushStepperQueue(MOTOR_B);
+  TEST_ASSERT_EQUAL_INT(0, board.setStepperGroup(MOTOR_A, MOTOR_GROUP_NONE));
+  TEST_ASSERT_EQUAL_INT(0, board.setStepperGroup(MOTOR_B, MOTOR_GROUP_NONE));
+}
+
+/**
+ * @brief Both motors stopped with one write to the all call address, the queues are flushed
+ */
+void test_stop_all(void){
+  board.stepperRotation(MOTOR_A, 50, 400);
+  board.stepperRotation(MOTOR_B, -50, 400);
+  TEST_ASSERT_EQUAL_INT(0, board.queueStepperRotation(MOTOR_A, -80, 50));
+  delay(5);
+  TEST_ASSERT_EQUAL_INT(1, nativeMotor[MOTOR_A].direction());
+  TEST_ASSERT_EQUAL_INT(-1, nativeMotor[MOTOR_B].direction());
+
+  spy.clear();
+  board.stopAllSteppers();
+  TEST_ASSERT_EQUAL_UINT(1, spy.count(PCA9629_ALLCALLADR >> 1));
+  TEST_ASSERT_EQUAL_UINT(0, spy.count(0x20));
+  TEST_ASSERT_EQUAL_UINT(0, spy.count(0x21));
+  TEST_ASSERT_EQUAL_INT(0, nativeMotor[MOTOR_A].direction());
+  TEST_ASSERT_EQUAL_INT(0, nativeMotor[MOTOR_B].direction());
+  TEST_ASSERT_EQUAL_INT(0, board.getQueuedRotationCount(MOTOR_A));
+  TEST_ASSERT_EQUAL_INT(STEPPER_STOPPED, board.getPredictedStepperState(MOTOR_A));
+  TEST_ASSERT_EQUAL_INT(STEPPER_STOPPED, board.getPredictedStepperState(MOTOR_B));
+}
+
+int main(int argc, char **argv){
+  nativeClock_useVirtual();
+  nativeBoard_attach();
+  Wire.attach(&spy);
+  Wire.begin();
+  board.begin();
+  UNITY_BEGIN();
+  RUN_TEST(test_prediction_matches_motor);
+  RUN_TEST(test_prediction_of_queued_move);
+  RUN_TEST(test_no_timeout_on_time);
+  RUN_TEST(test_timeout_on_overrun);
+  RUN_TEST(test_motor_not_fitted);
+  RUN_TEST(test_group_start);
+  RUN_TEST(test_group_start_rejected);
+  RUN_TEST(test_stop_all);
+  return UNITY_END();
+}
@@ -0,0 +1,139 @@
+/**
+ * @file test_ntc_table.cpp
+ * @brief Unit tests of the integer NTC conversion: every ADC code is converted with the table and
+ *        with the float beta equation of the former calcNTCTemp(), the temperatures truncated to
+ *        0.1 degree as displayed must match within NTC_TOLERANCE_TENTHS.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark The tolerance holds from NTC_RANGE_MIN to NTC_RANGE_MAX, outside the linear interpolation
+ *         of the first and last table intervals only keeps the conversion monotonic
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <Arduino.h>
+#include <math.h>
+#include <stdlib.h>
+#include <unity.h>
+#include "ntcTable.h"
+
+// Default NTC settings of main.cpp (NTCsensor)
+#define NTC_BETA 3435
+#define NTC_RTH0 10000
+#define NTC_TH0 25
+#define NTC_RREF 9970
+#define NTC_VCC 3.3
+
+// Temperatures checked against the float equation [degree]
+#define NTC_RANGE_MIN -40
+#define NTC_RANGE_MAX 60
+// Difference allowed between the truncated temperatures [0.1 degree]: the table is within 0.03
+// degree, a value close to a 0.1 degree step can still be truncated to the step below
+#define NTC_TOLERANCE_TENTHS 1
+
+static NTC_TABLE table;
+
+void setUp(void){
+}
+
+void tearDown(void){
+}
+
+/**
+ * @brief calcNTCTemp() as it was in main.cpp, the voltage is a float so that the 16 bit codes are
+ *        not rounded to the millivolt
+ *
+ * @param UR10K Ref. Resistor input voltage [mV]
+ * @return float Temperature in degree C
+ */
+static float baselineNTCTemp(float UR10K){
+  float RT, ln, TX, T0, Rvoltage;
+
+  T0 = NTC_TH0 + 273.15;
+  Rvoltage = UR10K/1000.0;
+  RT = (NTC_VCC - Rvoltage) / (Rvoltage/NTC_RREF);
+  ln = log(RT / NTC_RTH0);
+  TX = (1 / ((ln / NTC_BETA) + (1 / T0)));
+  return TX - 273.15;
+}
+
+/**
+ * @brief Temperature truncated to 0.1 degree as the former measure did (Temp*100, /10 in int)
+ */
+static int baselineTenths(float temperature){
+  return (int)(temperature * 100) / 10;
+}
+
+/**
+ * @brief Compare the table and the float equation on every code of the resolution
+ *
+ * @param codeBits ADC resolution
+ * @param milliVolts true to round the voltage to the millivolt as the 10 bit measure did
+ */
+static void sweep(unsigned char codeBits, bool milliVolts){
+  unsigned long fullScale = (1UL << codeBits) - 1;
+  unsigned long code;
+  unsigned long checked = 0;
+  int worst = 0;
+  char message[64];
+
+  for(code=1; code<fullScale; code++){
+    float voltage = milliVolts ? (float)((3300 * code) / fullScale) : 3300.0f * code / fullScale;
+    float temperature = baselineNTCTemp(voltage);
+    int tenths, difference;
+
+    if(temperature < NTC_RANGE_MIN || temperature > NTC_RANGE_MAX)
+      continue;
+    tenths = ntcTable_centiDegrees(&table, code, codeBits) / 10;
+    difference = abs(tenths - baselineTenths(temperature));
+    if(difference > worst)
+      worst = difference;
+    checked++;
+    snprintf(message, sizeof(message), "code %lu of %u bits", code, codeBits);
+    TEST_ASSERT_INT_WITHIN_MESSAGE(NTC_TOLERANCE_TENTHS, baselineTenths(temperature), tenths, message);
+  }
+  snprintf(message, sizeof(message), "%u bits: %lu codes, worst %d x 0.1 degree", codeBits, checked, worst);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_GREATER_THAN(0, checked);
+}
+
+/**
+ * @brief 10 bit codes through the former measure (analogRead, voltage in integer millivolts)
+ */
+void test_sweep_10bit_codes(void){
+  sweep(10, true);
+}
+
+/**
+ * @brief 16 bit codes of the ADC sampler
+ */
+void test_sweep_16bit_codes(void){
+  sweep(16, false);
+}
+
+/**
+ * @brief The temperature never decreases when the code increases, limits included
+ */
+void test_monotonic(void){
+  unsigned long code;
+  int previous = ntcTable_centiDegrees(&table, 0, 16);
+
+  TEST_ASSERT_EQUAL_INT(NTC_TABLE_MIN, previous);
+  for(code=1; code<=0xFFFF; code++){
+    int centiDegrees = ntcTable_centiDegrees(&table, code, 16);
+
+    TEST_ASSERT_TRUE_MESSAGE(centiDegrees >= previous, "decreasing temperature");
+    previous = centiDegrees;
+  }
+  TEST_ASSERT_EQUAL_INT(NTC_TABLE_MAX, previous);
+}
+
+int main(int argc, char **argv){
+  ntcTable_build(&table, NTC_BETA, NTC_RTH0, NTC_TH0, NTC_RREF);
+  UNITY_BEGIN();
+  RUN_TEST(test_sweep_10bit_codes);
+  RUN_TEST(test_sweep_16bit_codes);
+  RUN_TEST(test_monotonic);
+  return UNITY_END();
+}
@@ -0,0 +1,354 @@
+/**
+ * @file test_sectioning.cpp
+ * @brief Unit tests of the cutting cycle: SectioningStateMachine::process() is driven with blade
+ *        strokes through fake inputs and actuators, the feed moves, the section count and the
+ *        led are checked for the retract, advance and trim cycles, then the time taken per
+ *        sample is measured.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark The prediction is disabled (lead 0), the thresholds are detected when they are reached
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "sectioningStateMachine.h"
+
+// Thresholds of the user setting [10 bit position units]
+#define TEST_THRESHOLD_CUT 150
+#define TEST_THRESHOLD_REWIND 800
+// Blade stroke, top and bottom positions [10 bit position units] and samples per half stroke
+#define TEST_STROKE_TOP 1000
+#define TEST_STROKE_BOTTOM 50
+#define TEST_STROKE_SAMPLES 200
+// Samples a feed move lasts in the fake motor
+#define TEST_MOVE_SAMPLES 5
+// Moves recorded by the fake actuators
+#define TEST_MAX_MOVES 16
+// Samples of the timing loop and mean time allowed per sample on the host [ns]
+#define TEST_TIMING_SAMPLES 400000UL
+#define TEST_TIMING_MAX_NS 2000
+
+typedef struct t_testMove{
+  bool queued;
+  int speed;
+  unsigned int feed;
+} TEST_MOVE;
+
+/**
+ * @brief Limit switch, feed motor and led of the cycle, the motor runs TEST_MOVE_SAMPLES polls
+ */
+class fakeSectioningIO : public SectioningInputs, public SectioningActuators{
+  public:
+    bool limitFree;
+    bool timeout;
+    int runningPolls;
+    int queuedMoves;
+    unsigned long now_ms;
+    TEST_MOVE moves[TEST_MAX_MOVES];
+    int moveCount;
+    int sections;
+    int faults;
+    int overlaps;
+    bool cutLed;
+
+    void clear(){
+      limitFree = true;
+      timeout = false;
+      runningPolls = 0;
+      queuedMoves = 0;
+      now_ms = 0;
+      moveCount = 0;
+      sections = 0;
+      faults = 0;
+      overlaps = 0;
+      cutLed = false;
+    }
+    bool canRetract(){
+      return limitFree;
+    }
+    int feedMotorState(){
+      if(timeout && runningPolls){
+        runningPolls = 0;
+        return -1;
+      }
+      if(runningPolls){
+        runningPolls--;
+        return 1;
+      }
+      // the queued move starts when the running one ends
+      if(queuedMoves){
+        queuedMoves--;
+        runningPolls = TEST_MOVE_SAMPLES;
+        return 1;
+      }
+      return 0;
+    }
+    int feedQueuedMoves(){
+      return queuedMoves;
+    }
+    unsigned long timeMs(){
+      return now_ms;
+    }
+    void feedMove(int speed, unsigned int feed){
+      // a move started on a running motor
+      if(runningPolls)
+        overlaps++;
+      record(false, speed, feed);
+      runningPolls = TEST_MOVE_SAMPLES;
+    }
+    void queueFeedMove(int speed, unsigned int feed){
+      record(true, speed, feed);
+      queuedMoves++;
+    }
+    void setCutLed(bool on){
+      cutLed = on;
+    }
+    void countSection(){
+      sections++;
+    }
+    void feedFault(){
+      queuedMoves = 0;
+      faults++;
+    }
+
+  private:
+    void record(bool queued, int speed, unsigned int feed){
+      if(moveCount >= TEST_MAX_MOVES)
+        return;
+      moves[moveCount].queued = queued;
+      moves[moveCount].speed = speed;
+      moves[moveCount].feed = feed;
+      moveCount++;
+    }
+};
+
+static fakeSectioningIO io;
+static BLADEPREDICTOR predictor;
+static CYCLE_TELEMETRY telemetry;
+static SLICERCONFIG machine;
+static SETTINGS user;
+
+void setUp(void){
+  io.clear();
+  predictor_init(&predictor, 0);
+  telemetry_init(&telemetry);
+  machine.BacklashCW = 10;
+  machine.BacklashCCW = 20;
+  machine.MovingSpeed = 80;
+  user.mode = MODE_NORMAL;
+  user.thicknessNormalMode = 100;
+  user.thicknessTrimmingMode = 300;
+  user.thresholdToCut = TEST_THRESHOLD_CUT;
+  user.thresholdToRewind = TEST_THRESHOLD_REWIND;
+}
+
+void tearDown(void){
+}
+
+/**
+ * @brief One sample per millisecond from a position to another [10 bit position units]
+ */
+static void move(SectioningStateMachine *cycle, bool retraction, unsigned int from, unsigned int to){
+  int i;
+
+  for(i=0;i<TEST_STROKE_SAMPLES;i++){
+    unsigned int position = from + ((long)to - (long)from) * i / TEST_STROKE_SAMPLES;
+
+    io.now_ms++;
+    cycle->process(&machine, &user, retraction, position << SECTION_THRESHOLD_SHIFT);
+  }
+}
+
+/**
+ * @brief Blade down through the threshold to cut, then up through the threshold to rewind
+ */
+static void stroke(SectioningStateMachine *cycle, bool retraction){
+  move(cycle, retraction, TEST_STROKE_TOP, TEST_STROKE_BOTTOM);
+  move(cycle, retraction, TEST_STROKE_BOTTOM, TEST_STROKE_TOP);
+}
+
+static void checkMove(int index, bool queued, int speed, unsigned int feed){
+  char message[32];
+
+  snprintf(message, sizeof(message), "move %d", index);
+  TEST_ASSERT_TRUE_MESSAGE(index < io.moveCount, message);
+  TEST_ASSERT_EQUAL_INT_MESSAGE(queued, io.moves[index].queued, message);
+  TEST_ASSERT_EQUAL_INT_MESSAGE(speed, io.moves[index].speed, message);
+  TEST_ASSERT_EQUAL_INT_MESSAGE(feed, io.moves[index].feed, message);
+}
+
+/**
+ * @brief With retraction: twice the thickness forward on the cut, the thickness and the CCW
+ *        backlash back on the rewind with the next advance queued
+ */
+void test_retract_cycle(void){
+  SectioningStateMachine cycle(&io, &io, &predictor, &telemetry);
+
+  stroke(&cycle, true);
+  checkMove(0, false, 80, 200);
+  checkMove(1, false, -80, 120);
+  checkMove(2, true, 80, 210);
+  TEST_ASSERT_EQUAL_INT(1, io.sections);
+  TEST_ASSERT_EQUAL_INT(SECTION_WAIT_CUT, cycle.getStep());
+  TEST_ASSERT_TRUE(io.cutLed);
+
+  stroke(&cycle, true);
+  checkMove(3, false, 80, 210);
+  checkMove(4, false, -80, 120);
+  TEST_ASSERT_EQUAL_INT(2, io.sections);
+  TEST_ASSERT_GREATER_THAN(0, telemetry_latency_ms(&telemetry, PHASE_REWIND, PHASE_RETRACT_DONE));
+  TEST_ASSERT_GREATER_THAN(0, telemetry_latency_ms(&telemetry, PHASE_CUT_START, PHASE_ADVANCE_DONE));
+}
+
+/**
+ * @brief Without retraction: the thickness forward on the cut, the next advance queued once the
+ *        blade has gone up
+ */
+void test_advance_cycle(void){
+  SectioningStateMachine cycle(&io, &io, &predictor, &telemetry);
+
+  stroke(&cycle, false);
+  checkMove(0, false, 80, 100);
+  checkMove(1, true, 80, 100);
+  TEST_ASSERT_EQUAL_INT(2, io.moveCount);
+  TEST_ASSERT_EQUAL_INT(SECTION_WAIT_CUT, cycle.getStep());
+
+  // one advance queued per stroke
+  stroke(&cycle, false);
+  checkMove(2, false, 80, 100);
+  checkMove(3, true, 80, 100);
+  TEST_ASSERT_EQUAL_INT(4, io.moveCount);
+  TEST_ASSERT_EQUAL_INT(1, io.queuedMoves);
+}
+
+/**
+ * @brief Trimming mode, the moves use the trimming thickness
+ */
+void test_trim_cycle(void){
+  SectioningStateMachine cycle(&io, &io, &predictor, &telemetry);
+
+  user.mode = MODE_TRIMMING;
+  stroke(&cycle, true);
+  checkMove(0, false, 80, 600);
+  checkMove(1, false, -80, 320);
+  checkMove(2, true, 80, 610);
+}
+
+/**
+ * @brief The specimen is not retracted when the lower limit switch is pressed
+ */
+void test_no_retract_at_limit(void){
+  SectioningStateMachine cycle(&io, &io, &predictor, &telemetry);
+
+  io.limitFree = false;
+  stroke(&cycle, true);
+  TEST_ASSERT_EQUAL_INT(1, io.moveCount);
+  TEST_ASSERT_EQUAL_INT(1, io.sections);
+  TEST_ASSERT_EQUAL_INT(SECTION_WAIT_CUT, cycle.getStep());
+}
+
+/**
+ * @brief A feed motor timeout stops the cycle until it is reset
+ */
+void test_timeout_stops_cycle(void){
+  SectioningStateMachine cycle(&io, &io, &predictor, &telemetry);
+
+  io.timeout = true;
+  stroke(&cycle, true);
+  TEST_ASSERT_EQUAL_INT(1, io.faults);
+  TEST_ASSERT_EQUAL_INT(SECTION_FAULT, cycle.getStep());
+  TEST_ASSERT_EQUAL_INT(1, io.moveCount);
+
+  // no move, even with new thresholds
+  user.thresholdToCut = TEST_THRESHOLD_CUT + 10;
+  stroke(&cycle, true);
+  TEST_ASSERT_EQUAL_INT(1, io.moveCount);
+  TEST_ASSERT_EQUAL_INT(SECTION_FAULT, cycle.getStep());
+
+  io.timeout = false;
+  cycle.reset();
+  stroke(&cycle, true);
+  TEST_ASSERT_EQUAL_INT(1, io.faults);
+  TEST_ASSERT_EQUAL_INT(4, io.moveCount);
+}
+
+/**
+ * @brief Thresholds changed while a feed move is running: the move is finished before the new
+ *        thresholds are taken, and no move is started on a running motor
+ */
+void test_threshold_change_during_move(void){
+  SectioningStateMachine cycle(&io, &io, &predictor, &telemetry);
+  unsigned int position = TEST_STROKE_TOP;
+
+  // down to the cut, the advance is started
+  while(cycle.getStep() != SECTION_WAIT_ADVANCE && position > TEST_STROKE_BOTTOM){
+    position -= 5;
+    io.now_ms++;
+    cycle.process(&machine, &user, true, position << SECTION_THRESHOLD_SHIFT);
+  }
+  TEST_ASSERT_EQUAL_INT(SECTION_WAIT_ADVANCE, cycle.getStep());
+
+  user.thresholdToCut = TEST_THRESHOLD_CUT + 50;
+  io.now_ms++;
+  cycle.process(&machine, &user, true, position << SECTION_THRESHOLD_SHIFT);
+  TEST_ASSERT_EQUAL_INT(SECTION_WAIT_ADVANCE, cycle.getStep());
+  TEST_ASSERT_EQUAL_INT(1, io.moveCount);
+
+  // end of the advance, the cycle goes on with the new thresholds
+  move(&cycle, true, position, TEST_STROKE_BOTTOM);
+  TEST_ASSERT_EQUAL_INT(SECTION_WAIT_REWIND, cycle.getStep());
+  TEST_ASSERT_EQUAL_INT(1, io.moveCount);
+
+  // up through the threshold to rewind, down to a cut only reached with the new threshold
+  move(&cycle, true, TEST_STROKE_BOTTOM, TEST_STROKE_TOP);
+  move(&cycle, true, TEST_STROKE_TOP, TEST_THRESHOLD_CUT + 10);
+  checkMove(1, false, -80, 120);
+  checkMove(2, true, 80, 210);
+  checkMove(3, false, 80, 210);
+  move(&cycle, true, TEST_THRESHOLD_CUT + 10, TEST_STROKE_BOTTOM);
+  stroke(&cycle, true);
+  TEST_ASSERT_EQUAL_INT(0, io.overlaps);
+  TEST_ASSERT_EQUAL_INT(3, io.sections);
+}
+
+/**
+ * @brief Mean time of process() per blade sample over full strokes
+ */
+void test_process_timing(void){
+  SectioningStateMachine cycle(&io, &io, &predictor, &telemetry);
+  char message[64];
+  unsigned long start_us;
+  unsigned long elapsed_us;
+  unsigned long i;
+  unsigned int position = TEST_STROKE_TOP;
+  int direction = -1;
+
+  start_us = micros();
+  for(i=0;i<TEST_TIMING_SAMPLES;i++){
+    cycle.process(&machine, &user, true, position << SECTION_THRESHOLD_SHIFT);
+    position += direction * 5;
+    if(position <= TEST_STROKE_BOTTOM || position >= TEST_STROKE_TOP)
+      direction = -direction;
+  }
+  elapsed_us = micros() - start_us;
+  snprintf(message, sizeof(message), "process(): %lu ns per sample, %d sections",
+             (unsigned long)(elapsed_us * 1000ULL / TEST_TIMING_SAMPLES), io.sections);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_GREATER_THAN(0, io.sections);
+  TEST_ASSERT_LESS_OR_EQUAL(TEST_TIMING_MAX_NS, elapsed_us * 1000ULL / TEST_TIMING_SAMPLES);
+}
+
+int main(int argc, char **argv){
+  UNITY_BEGIN();
+  RUN_TEST(test_retract_cycle);
+  RUN_TEST(test_advance_cycle);
+  RUN_TEST(test_trim_cycle);
+  RUN_TEST(test_no_retract_at_limit);
+  RUN_TEST(test_timeout_stops_cycle);
+  RUN_TEST(test_threshold_change_during_move);
+  RUN_TEST(test_process_timing);
+  return UNITY_END();
+}
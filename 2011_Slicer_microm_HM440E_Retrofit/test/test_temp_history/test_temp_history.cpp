@@ -0,0 +1,116 @@
+/**
+ * @file test_temp_history.cpp
+ * @brief Unit tests of the temperature trend: least squares slope of a known linear drift and time
+ *        left until a threshold, -1 when there is no trend, too few samples or when the trend goes
+ *        away from the threshold.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @remark One measure per second as the temperature task, TEMP_HISTORY_PERIOD_S measures per sample
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "tempHistory.h"
+
+// Temperature at the first measure [centi-degrees]
+#define START_CENTI_DEGREES 2500
+// Drift of the linear measures, 1 centi-degree per second = 36 degrees per hour
+#define DRIFT_CENTI_DEGREES_PER_HOUR 3600
+
+static TEMP_HISTORY history;
+
+void setUp(void){
+  tempHistory_init(&history);
+}
+
+void tearDown(void){
+}
+
+/**
+ * @brief Add the measures of samples x TEMP_HISTORY_PERIOD_S seconds with a linear drift
+ *
+ * @param samples samples stored
+ * @param centiDegreesPerSecond drift, 0 for a constant temperature
+ */
+static void addDrift(unsigned int samples, int centiDegreesPerSecond){
+  unsigned int second;
+
+  for(second=0; second<samples * TEMP_HISTORY_PERIOD_S; second++)
+    tempHistory_add(&history, START_CENTI_DEGREES + centiDegreesPerSecond * (int)second);
+}
+
+/**
+ * @brief A rising drift gives its slope and the time left to a threshold above the last sample
+ */
+void test_linear_drift(void){
+  long slope = 0;
+  int last;
+
+  addDrift(TEMP_HISTORY_TREND_SAMPLES, 1);
+  TEST_ASSERT_EQUAL_UINT(TEMP_HISTORY_TREND_SAMPLES, tempHistory_count(&history));
+  TEST_ASSERT_EQUAL_INT(0, tempHistory_slope(&history, &slope));
+  TEST_ASSERT_EQUAL_INT(DRIFT_CENTI_DEGREES_PER_HOUR, slope);
+  last = tempHistory_sample(&history, 0);
+  TEST_ASSERT_EQUAL_INT(100, tempHistory_timeToReach_s(&history, last + 100));
+  TEST_ASSERT_EQUAL_INT(3600, tempHistory_timeToReach_s(&history, last + DRIFT_CENTI_DEGREES_PER_HOUR));
+}
+
+/**
+ * @brief A falling drift reaches a threshold below the last sample
+ */
+void test_falling_drift(void){
+  long slope = 0;
+
+  addDrift(TEMP_HISTORY_TREND_SAMPLES, -1);
+  TEST_ASSERT_EQUAL_INT(0, tempHistory_slope(&history, &slope));
+  TEST_ASSERT_EQUAL_INT(-DRIFT_CENTI_DEGREES_PER_HOUR, slope);
+  TEST_ASSERT_EQUAL_INT(60, tempHistory_timeToReach_s(&history, tempHistory_sample(&history, 0) - 60));
+}
+
+/**
+ * @brief A constant temperature has a null slope, no threshold is reached
+ */
+void test_no_trend(void){
+  long slope = -1;
+
+  addDrift(TEMP_HISTORY_TREND_SAMPLES, 0);
+  TEST_ASSERT_EQUAL_INT(0, tempHistory_slope(&history, &slope));
+  TEST_ASSERT_EQUAL_INT(0, slope);
+  TEST_ASSERT_EQUAL_INT(-1, tempHistory_timeToReach_s(&history, START_CENTI_DEGREES + 100));
+  TEST_ASSERT_EQUAL_INT(-1, tempHistory_timeToReach_s(&history, START_CENTI_DEGREES - 100));
+}
+
+/**
+ * @brief A rising drift never reaches a threshold below the last sample
+ */
+void test_wrong_direction(void){
+  addDrift(TEMP_HISTORY_TREND_SAMPLES, 1);
+  TEST_ASSERT_EQUAL_INT(-1, tempHistory_timeToReach_s(&history, START_CENTI_DEGREES));
+}
+
+/**
+ * @brief Under TEMP_HISTORY_MIN_TREND samples the trend is unknown
+ */
+void test_too_few_samples(void){
+  long slope = 0;
+
+  addDrift(TEMP_HISTORY_MIN_TREND - 1, 1);
+  TEST_ASSERT_EQUAL_INT(-1, tempHistory_slope(&history, &slope));
+  TEST_ASSERT_EQUAL_INT(-1, tempHistory_timeToReach_s(&history, START_CENTI_DEGREES + 1000));
+  // the measures of the next sample complete the minimum
+  addDrift(1, 1);
+  TEST_ASSERT_EQUAL_INT(0, tempHistory_slope(&history, &slope));
+}
+
+int main(int argc, char **argv){
+  UNITY_BEGIN();
+  RUN_TEST(test_linear_drift);
+  RUN_TEST(test_falling_drift);
+  RUN_TEST(test_no_trend);
+  RUN_TEST(test_wrong_direction);
+  RUN_TEST(test_too_few_samples);
+  return UNITY_END();
+}
@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""Compare the I2C transfers of each cutting cycle with a golden trace.
+
+The traces are written by the firmware built with -DI2C_TRACE (src/i2cTrace.h): in
+i2c_trace.txt on the host, over the serial port on the target ('t' command). A trace is cut
+into cycles at its C marks, the transfers before the first mark (setup, menus) are not
+compared. A trace or its summary (--summary) can be given on both sides.
+
+  i2c_trace_compare.py --summary trace.txt > golden.txt    per cycle summary of a trace
+  i2c_trace_compare.py trace.txt golden.txt                 compare, exit 1 on a regression
+
+Transfers and bytes on the bus of each record: W register write 1 transfer, address, register
+and data bytes; R register read 2 transfers (register pointer, then data), 2 address bytes,
+register and data bytes; w and r 1 transfer, address and data bytes.
+
+The golden trace tools/i2c_trace_golden.txt is the summary of the native session of 0.05 h
+(env:native built with -DI2C_TRACE, see lib/ArduinoNative/src/NativeSession.h), which is
+replayed identically on each run:
+
+  ARDUINO_NATIVE_SESSION=0.05 .pio/build/native/program
+  tools/i2c_trace_compare.py i2c_trace.txt tools/i2c_trace_golden.txt
+"""
+
+import argparse
+import statistics
+import sys
+
+SUMMARY_HEADER = "# i2c trace summary: cycle device transfers bytes"
+
+
+def record_cost(kind, length):
+    """Transfers and bytes on the bus of a record."""
+    if kind == "W":
+        return 1, 2 + length
+    if kind == "R":
+        return 2, 3 + length
+    return 1, 1 + length
+
+
+def read_cycles(path):
+    """List of cycles, each a dict device -> [transfers, bytes]."""
+    cycles = []
+    with open(path) as trace:
+        lines = trace.read().splitlines()
+    if lines and lines[0] == SUMMARY_HEADER:
+        for line in lines[1:]:
+            if not line.strip():
+                continue
+            cycle, device, transfers, size = line.split()
+            cycle = int(cycle)
+            while len(cycles) < cycle:
+                cycles.append({})
+            cycles[cycle - 1][int(device, 16)] = [int(transfers), int(size)]
+        return cycles
+    current = None
+    for number, line in enumerate(lines, 1):
+        fields = line.split()
+        if not fields:
+            continue
+        # lines of the serial port that are not records
+        if len(fields) < 2 or not fields[0].isdigit():
+            continue
+        if fields[1] == "C":
+            current = {}
+            cycles.append(current)
+            continue
+        if len(fields) != 5 or fields[1] not in "WRwr":
+            sys.exit("%s:%d: not a trace record: %s" % (path, number, line))
+        if current is None:
+            continue
+        transfers, size = record_cost(fields[1], int(fields[4]))
+        totals = current.setdefault(int(fields[2], 16), [0, 0])
+        totals[0] += transfers
+        totals[1] += size
+    # the last cycle is cut by the end of the trace
+    if cycles:
+        cycles.pop()
+    return cycles
+
+
+def print_summary(cycles):
+    print(SUMMARY_HEADER)
+    for index, cycle in enumerate(cycles, 1):
+        for device in sorted(cycle):
+            print("%d %02x %d %d" % (index, device, cycle[device][0], cycle[device][1]))
+
+
+def column(cycles, device, field):
+    return [cycle.get(device, [0, 0])[field] for cycle in cycles]
+
+
+def statistics_line(values):
+    if not values:
+        return (0, 0.0, 0)
+    return (statistics.median(values), statistics.mean(values), max(values))
+
+
+def compare(current, golden, tolerance, shown):
+    devices = sorted(set(d for c in current + golden for d in c))
+    regression = False
+
+    print("cycles: %d golden, %d current" % (len(golden), len(current)))
+    print("%-6s %-9s %-23s %-23s" % ("device", "per cycle", "golden median/mean/max", "current median/mean/max"))
+    for device in devices:
+        for field, name in ((0, "transfers"), (1, "bytes")):
+            old = statistics_line(column(golden, device, field))
+            new = statistics_line(column(current, device, field))
+            limit = 1 + tolerance / 100.0
+            worse = new[0] > old[0] * limit or new[1] > old[1] * limit
+            regression = regression or worse
+            print("0x%02x   %-9s %7g %7.1f %7d %7g %7.1f %7d%s" %
+                  (device, name, old[0], old[1], old[2], new[0], new[1], new[2], "  <--" if worse else ""))
+    # same session replayed: the cycles are compared one by one
+    if len(current) == len(golden):
+        differences = 0
+        for index, (new, old) in enumerate(zip(current, golden), 1):
+            if new == old:
+                continue
+            differences += 1
+            if differences <= shown:
+                changes = []
+                for device in devices:
+                    a = old.get(device, [0, 0])
+                    b = new.get(device, [0, 0])
+                    if a != b:
+                        changes.append("0x%02x %+d transfers %+d bytes" % (device, b[0] - a[0], b[1] - a[1]))
+                print("cycle %d: %s" % (index, ", ".join(changes)))
+        print("%d cycles differ" % differences)
+    return regression
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare the I2C transfers per cutting cycle with a golden trace")
+    parser.add_argument("trace", help="trace or summary to check")
+    parser.add_argument("golden", nargs="?", help="golden trace or summary")
+    parser.add_argument("--summary", action="store_true", help="print the per cycle summary of the trace")
+    parser.add_argument("--tolerance", type=float, default=0.0, help="increase allowed per cycle [%%], 0 by default")
+    parser.add_argument("--cycles", type=int, default=10, help="cycles listed when the cycles differ")
+    args = parser.parse_args()
+
+    if args.summary:
+        print_summary(read_cycles(args.trace))
+        return 0
+    if not args.golden:
+        parser.error("the golden trace is needed to compare")
+    current = read_cycles(args.trace)
+    golden = read_cycles(args.golden)
+    if not current or not golden:
+        sys.exit("no complete cycle in the traces")
+    return 1 if compare(current, golden, args.tolerance, args.cycles) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""Compare the report of a native session with the expected figures.
+
+The report is printed by the native build at the end of a session (ARDUINO_NATIVE_SESSION,
+see lib/ArduinoNative/src/NativeSession.h): handwheel revolutions and bursts, motor positions,
+display writes while busy, then the home and diagnostics screens, read for the section
+counter, the stroke rate, the retract and advance latencies and the motor timeouts.
+
+  session_compare.py --summary report.txt > golden.txt    figures of a report
+  session_compare.py report.txt golden.txt                 compare, exit 1 on a regression
+
+The session is replayed identically on each run, so the counts must match the golden figures
+exactly: a section, revolution or step more or less is a regression. The latencies may
+decrease, an increase over --tolerance is a regression. The golden figures
+tools/session_golden.txt are those of the session of 0.05 h:
+
+  ARDUINO_NATIVE_SESSION=0.05 .pio/build/native/program > report.txt
+  tools/session_compare.py report.txt tools/session_golden.txt
+"""
+
+import argparse
+import re
+import sys
+
+SUMMARY_HEADER = "# native session figures: name value"
+
+# name, pattern of the report, compared exactly (True) or as a latency (False)
+FIGURES = (
+    ("revolutions", r"^handwheel: (\d+) revolutions", True),
+    ("bursts", r"^handwheel: \d+ revolutions in (\d+) bursts", True),
+    ("motor_a_steps", r"^motor A: position (-?\d+) steps", True),
+    ("motor_b_steps", r"^motor B: position (-?\d+) steps", True),
+    ("busy_writes", r"^display: (\d+) writes while busy", True),
+    ("counter", r"^\|Counter=(\d+)", True),
+    ("timeouts", r"Timeouts=(\d+)", True),
+    ("rate", r"\|Rate   = *(\d+) ", True),
+    ("retract_ms", r"\|Retract= *(\d+) ", False),
+    ("advance_ms", r"\|Advance= *(\d+) ", False),
+)
+
+
+def read_figures(path):
+    """Dict name -> value of a report or of a summary."""
+    with open(path) as report:
+        lines = report.read().splitlines()
+    figures = {}
+    if lines and lines[0] == SUMMARY_HEADER:
+        for line in lines[1:]:
+            if line.strip():
+                name, value = line.split()
+                figures[name] = int(value)
+        return figures
+    for name, pattern, _ in FIGURES:
+        for line in lines:
+            match = re.search(pattern, line)
+            if match:
+                figures[name] = int(match.group(1))
+                break
+    return figures
+
+
+def print_summary(figures):
+    print(SUMMARY_HEADER)
+    for name, _, _ in FIGURES:
+        if name in figures:
+            print("%s %d" % (name, figures[name]))
+
+
+def compare(current, golden, tolerance):
+    regression = False
+
+    print("%-14s %8s %8s" % ("figure", "golden", "current"))
+    for name, _, exact in FIGURES:
+        if name not in golden:
+            continue
+        old = golden[name]
+        new = current.get(name)
+        if new is None:
+            worse = True
+            note = "  <-- missing"
+        elif exact:
+            worse = new != old
+            note = "  <--" if worse else ""
+        else:
+            worse = new > old * (1 + tolerance / 100.0)
+            note = "  <--" if worse else ("  faster, update the golden figures" if new < old else "")
+        regression = regression or worse
+        print("%-14s %8d %8s%s" % (name, old, "-" if new is None else new, note))
+    return regression
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare the report of a native session with the expected figures")
+    parser.add_argument("report", help="report or summary to check")
+    parser.add_argument("golden", nargs="?", help="golden report or summary")
+    parser.add_argument("--summary", action="store_true", help="print the figures of the report")
+    parser.add_argument("--tolerance", type=float, default=0.0, help="latency increase allowed [%%], 0 by default")
+    args = parser.parse_args()
+
+    if args.summary:
+        print_summary(read_figures(args.report))
+        return 0
+    if not args.golden:
+        parser.error("the golden figures are needed to compare")
+    current = read_figures(args.report)
+    golden = read_figures(args.golden)
+    if not golden:
+        sys.exit("no figure in the golden report")
+    return 1 if compare(current, golden, args.tolerance) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())